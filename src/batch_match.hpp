@@ -0,0 +1,175 @@
+#ifndef BATCH_MATCH_HPP
+#define BATCH_MATCH_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "literal_search.hpp"
+#include "match_result.hpp"
+#include "utilities/literal_string_view.hpp"
+#include "utilities/match_length.hpp"
+#include "utilities/segmented_view.hpp"
+
+namespace e_regex
+{
+    // Position of a match, as offsets from the beginning of the query
+    struct match_span
+    {
+            std::uint32_t offset;
+            std::uint32_t length;
+
+            constexpr auto operator==(const match_span& other) const noexcept -> bool = default;
+    };
+
+    struct match_batch
+    {
+            // Number of spans written
+            std::size_t count;
+
+            /*
+                Offset to resume from, equal to the query size when the query is exhausted.
+                Regexes matching the empty string can still match at the end of the query, for
+                them it is one past the size once the end has been tried
+            */
+            std::uint32_t next_offset;
+    };
+
+    /*
+        Capture-free iteration over every match of a query, offsets are 32 bits
+        so queries must be shorter than 4 GiB
+    */
+    template<typename matcher, typename Char_Type = char>
+    struct batch_match
+    {
+            /**
+             * @brief Calls callback with the match_span of every match starting from offset
+             * from, stops early if callback returns false
+             *
+             * @return the offset to resume from
+             */
+            template<typename Query = literal_string_view<Char_Type>>
+            static constexpr auto for_each(Query         query,
+                                           auto&&        callback,
+                                           std::uint32_t from = 0) noexcept -> std::uint32_t
+            {
+                const auto size = static_cast<std::size_t>(query.size());
+
+                if (from > size)
+                {
+                    return from;
+                }
+
+                const auto report = [&](match_span span) -> bool
+                {
+                    if constexpr (std::same_as<decltype(callback(span)), bool>)
+                    {
+                        return callback(span);
+                    }
+                    else
+                    {
+                        callback(span);
+                        return true;
+                    }
+                };
+
+                match_cursor<Char_Type, Query> data;
+                data.query                 = query;
+                data.actual_iterator_start = query.begin() + from;
+
+                while (data.actual_iterator_start < query.end()
+                       && fits_length<matcher::min_length>(data.actual_iterator_start, query.end()))
+                {
+                    if constexpr (literal_pattern<matcher>::value
+                                  && std::is_same_v<Query, literal_string_view<char>>)
+                    {
+                        // Jump straight to the next occurrence of plain strings
+                        data.actual_iterator_start = find_literal(
+                            data.actual_iterator_start,
+                            query.end(),
+                            literal_needle<typename literal_pattern<matcher>::string>::value);
+
+                        if (data.actual_iterator_start == query.end())
+                        {
+                            break;
+                        }
+                    }
+
+                    data.actual_iterator_end = data.actual_iterator_start;
+                    data.accepted            = true;
+
+                    auto result = matcher::match(data);
+
+                    if (!result)
+                    {
+                        data.actual_iterator_start++;
+                        continue;
+                    }
+
+                    const match_span span {
+                        .offset = static_cast<std::uint32_t>(result.actual_iterator_start - query.begin()),
+                        .length = static_cast<std::uint32_t>(result.actual_iterator_end
+                                                             - result.actual_iterator_start)};
+
+                    // Empty matches must not be found twice
+                    data.actual_iterator_start = result.actual_iterator_end + (span.length == 0 ? 1 : 0);
+
+                    if (!report(span))
+                    {
+                        return static_cast<std::uint32_t>(data.actual_iterator_start - query.begin());
+                    }
+                }
+
+                if constexpr (matcher::min_length == 0)
+                {
+                    // Only empty matches can start at the end of the query
+                    data.actual_iterator_start = data.actual_iterator_end = query.end();
+                    data.accepted                                        = true;
+
+                    if (matcher::match(data))
+                    {
+                        report(match_span {.offset = static_cast<std::uint32_t>(size), .length = 0});
+                    }
+
+                    return static_cast<std::uint32_t>(size + 1);
+                }
+                else
+                {
+                    return static_cast<std::uint32_t>(size);
+                }
+            }
+
+            /**
+             * @brief Writes the spans of the matches starting from offset from into out, until
+             * it is full
+             */
+            template<typename Query = literal_string_view<Char_Type>>
+            static constexpr auto find_all(Query                 query,
+                                           std::span<match_span> out,
+                                           std::uint32_t         from = 0) noexcept -> match_batch
+            {
+                match_batch batch {.count = 0, .next_offset = from};
+
+                if (out.empty())
+                {
+                    return batch;
+                }
+
+                batch.next_offset = for_each(
+                    query,
+                    [&](match_span span)
+                    {
+                        out[batch.count++] = span;
+
+                        return batch.count < out.size();
+                    },
+                    from);
+
+                return batch;
+            }
+    };
+}// namespace e_regex
+
+#endif /* BATCH_MATCH_HPP */
@@ -0,0 +1,305 @@
+#ifndef BNDM_SEARCH_HPP
+#define BNDM_SEARCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "literal_search.hpp"
+#include "nodes.hpp"
+#include "utilities/byte_set.hpp"
+
+namespace e_regex
+{
+    // Bytes admitted at each position of a fixed length pattern
+    struct class_sequence
+    {
+            static constexpr std::size_t max_length = 64;
+
+            std::array<byte_set, max_length> sets   = {};
+            std::size_t                      length = 0;
+            bool                             valid  = true;
+
+            static constexpr auto invalid() noexcept -> class_sequence
+            {
+                class_sequence sequence;
+                sequence.valid = false;
+
+                return sequence;
+            }
+
+            friend constexpr auto operator+(class_sequence first, const class_sequence& second) noexcept
+                -> class_sequence
+            {
+                if (!first.valid || !second.valid || first.length + second.length > max_length)
+                {
+                    return invalid();
+                }
+
+                for (std::size_t i = 0; i < second.length; ++i)
+                {
+                    first.sets[first.length++] = second.sets[i];
+                }
+
+                return first;
+            }
+
+            // Number of positions admitting different bytes
+            constexpr auto differences(const class_sequence& other) const noexcept -> std::size_t
+            {
+                std::size_t count = 0;
+
+                for (std::size_t i = 0; i < length && i < other.length; ++i)
+                {
+                    count += !(sets[i] == other.sets[i]);
+                }
+
+                return count;
+            }
+
+            // Alternatives of the same length are merged position by position
+            friend constexpr auto operator|(class_sequence first, const class_sequence& second) noexcept
+                -> class_sequence
+            {
+                if (!first.valid || !second.valid || first.length != second.length)
+                {
+                    return invalid();
+                }
+
+                for (std::size_t i = 0; i < first.length; ++i)
+                {
+                    first.sets[i] = first.sets[i] | second.sets[i];
+                }
+
+                return first;
+            }
+    };
+
+    /*
+        Single character nodes are described by their alphabet, zero length nodes are ignored.
+        Merged alternatives may admit more sequences than the pattern, which is fine for
+        filtering candidates
+    */
+    struct alphabet_classes
+    {
+            static constexpr bool ignores_empty_nodes = true;
+            static constexpr bool approximates_merges = true;
+
+            template<typename T>
+            static consteval auto of() -> byte_set
+            {
+                return nodes::alphabet_getter<T>::value;
+            }
+    };
+
+    template<typename T, typename leaf_classes = alphabet_classes>
+    consteval auto classes_of() -> class_sequence;
+
+    template<typename leaf_classes>
+    consteval auto classes_of_node(const void*) -> class_sequence
+    {
+        return class_sequence::invalid();
+    }
+
+    template<typename leaf_classes, typename... identifiers>
+    consteval auto classes_of_node(const terminals::terminal<identifiers...>*) -> class_sequence
+    {
+        if constexpr (sizeof...(identifiers) == 1)
+        {
+            return class_sequence::invalid();
+        }
+        else
+        {
+            return (class_sequence {} + ... + classes_of<terminals::terminal<identifiers>, leaf_classes>());
+        }
+    }
+
+    /*
+        Alternatives differing in more than one position merge into extra sequences, e.g.
+        ab|cd would admit ad: they are only accepted by policies that approximate
+    */
+    template<typename leaf_classes, typename child, typename... children>
+    consteval auto merge_alternatives() -> class_sequence
+    {
+        auto sequence = classes_of<child, leaf_classes>();
+
+        if constexpr (sizeof...(children) > 0)
+        {
+            const auto others = merge_alternatives<leaf_classes, children...>();
+
+            if (!leaf_classes::approximates_merges && sequence.differences(others) > 1)
+            {
+                return class_sequence::invalid();
+            }
+
+            sequence = sequence | others;
+        }
+
+        return sequence;
+    }
+
+    template<typename leaf_classes, typename... children>
+    consteval auto alternatives_classes() -> class_sequence
+    {
+        if constexpr (sizeof...(children) == 0)
+        {
+            return class_sequence {};
+        }
+        else
+        {
+            return merge_alternatives<leaf_classes, children...>();
+        }
+    }
+
+    template<typename leaf_classes, typename matcher, typename... children>
+    consteval auto classes_of_node(const nodes::simple<matcher, children...>*) -> class_sequence
+    {
+        return classes_of<matcher, leaf_classes>() + alternatives_classes<leaf_classes, children...>();
+    }
+
+    template<typename leaf_classes, typename matcher, auto group_index, typename... children>
+    consteval auto classes_of_node(const nodes::group<matcher, group_index, children...>*) -> class_sequence
+    {
+        return classes_of<matcher, leaf_classes>() + alternatives_classes<leaf_classes, children...>();
+    }
+
+    template<typename leaf_classes, typename matcher, std::size_t repetitions, typename... children>
+    consteval auto classes_of_node(const nodes::repeated<matcher, repetitions, children...>*)
+        -> class_sequence
+    {
+        class_sequence sequence;
+        for (std::size_t i = 0; i < repetitions; ++i)
+        {
+            sequence = sequence + classes_of<matcher, leaf_classes>();
+        }
+
+        return sequence + alternatives_classes<leaf_classes, children...>();
+    }
+
+    /*
+        Position by position description of patterns whose matches all have the same length,
+        invalid if the pattern is not made of fixed sequences of classes. leaf_classes gives
+        the set of single character nodes
+    */
+    template<typename T, typename leaf_classes>
+    consteval auto classes_of() -> class_sequence
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            return class_sequence {};
+        }
+        else if constexpr (T::max_length == 0)
+        {
+            return leaf_classes::ignores_empty_nodes ? class_sequence {} : class_sequence::invalid();
+        }
+        else if constexpr (T::min_length != T::max_length || T::max_length > class_sequence::max_length)
+        {
+            return class_sequence::invalid();
+        }
+        else if constexpr (T::max_length == 1)
+        {
+            class_sequence sequence;
+            sequence.sets[sequence.length++] = leaf_classes::template of<T>();
+
+            return sequence;
+        }
+        else if constexpr (exact_terminal<T>)
+        {
+            class_sequence sequence;
+            for (auto c: literal_needle<exact_chars_t<T>>::value)
+            {
+                sequence.sets[sequence.length++] = byte_set::of(c);
+            }
+
+            return sequence;
+        }
+        else
+        {
+            return classes_of_node<leaf_classes>(static_cast<const T*>(nullptr));
+        }
+    }
+
+    // Fixed length sequences of classes, literals have their own search
+    template<typename matcher>
+    concept bndm_searchable = !literal_pattern<matcher>::value && classes_of<matcher>().valid
+                              && classes_of<matcher>().length >= 2;
+
+    // Bit length - 1 - i of masks[c] is set if c is admitted at position i
+    template<typename matcher>
+    consteval auto bndm_masks() -> std::array<std::uint64_t, 256>
+    {
+        constexpr auto                 classes = classes_of<matcher>();
+        std::array<std::uint64_t, 256> masks   = {};
+
+        for (std::size_t i = 0; i < classes.length; ++i)
+        {
+            for (unsigned c = 0; c < masks.size(); ++c)
+            {
+                if (classes.sets[i].contains(static_cast<unsigned char>(c)))
+                {
+                    masks[c] |= std::uint64_t {1} << (classes.length - 1 - i);
+                }
+            }
+        }
+
+        return masks;
+    }
+
+    /*
+        Backward nondeterministic DAWG matching: each window of the pattern length is read
+        backward with a bit-parallel automaton of the reversed pattern. Windows that cannot
+        contain a match are skipped entirely, otherwise the window moves to the last prefix
+        of the pattern found while reading it. Alphabets can admit more than the pattern
+        does, so full windows are verified with attempt
+    */
+    template<typename matcher>
+    constexpr auto bndm_search(const char* start, const char* end, auto&& attempt) noexcept -> bool
+    {
+        constexpr auto classes = classes_of<matcher>();
+        constexpr auto length  = static_cast<std::ptrdiff_t>(classes.length);
+
+        constexpr auto masks   = bndm_masks<matcher>();
+
+        constexpr auto prefix_bit = std::uint64_t {1} << (classes.length - 1);
+
+        while (end - start >= length)
+        {
+            auto          position = length;
+            auto          shift    = length;
+            auto          found    = false;
+            std::uint64_t state    = ~std::uint64_t {0};
+
+            while (position > 0 && state != 0)
+            {
+                state &= masks[static_cast<unsigned char>(start[position - 1])];
+                --position;
+
+                if ((state & prefix_bit) != 0)
+                {
+                    if (position > 0)
+                    {
+                        shift = position;
+                    }
+                    else
+                    {
+                        found = true;
+                    }
+                }
+
+                state <<= 1;
+            }
+
+            if (found && attempt(start))
+            {
+                return true;
+            }
+
+            start += shift;
+        }
+
+        return false;
+    }
+}// namespace e_regex
+
+#endif /* BNDM_SEARCH_HPP */
@@ -0,0 +1,107 @@
+#ifndef BOOLEAN_MATCH_HPP
+#define BOOLEAN_MATCH_HPP
+
+#include <type_traits>
+
+#include "class_validator.hpp"
+#include "literal_search.hpp"
+#include "match_result.hpp"
+#include "nodes/basic.hpp"
+#include "terminals/anchors/end.hpp"
+#include "utilities/literal_string_view.hpp"
+#include "utilities/match_length.hpp"
+#include "utilities/segmented_view.hpp"
+
+namespace e_regex
+{
+    /*
+        Yes/no tests: no capture is recorded and the first accepted path
+        ends the search, the longest match is never computed. Queries can be
+        contiguous or segmented
+    */
+    template<typename matcher, typename Char_Type = char>
+    struct boolean_match
+    {
+            /**
+             * @brief Checks if the regex matches somewhere in query
+             */
+            template<typename Query = literal_string_view<Char_Type>>
+            static constexpr auto contains(Query query) noexcept -> bool
+            {
+                if constexpr (literal_pattern<matcher>::value
+                              && std::is_same_v<Query, literal_string_view<char>>)
+                {
+                    constexpr auto needle = literal_needle<typename literal_pattern<matcher>::string>::value;
+
+                    return find_literal(query.begin(), query.end(), needle) != query.end();
+                }
+
+                if (!fits_length<matcher::min_length>(query.begin(), query.end())
+                    || !nodes::required_bytes_present<matcher>(query.begin(), query.end()))
+                {
+                    return false;
+                }
+
+                test_cursor<Char_Type, Query> data;
+                data.query                 = query;
+                data.actual_iterator_start = query.begin();
+
+                do
+                {
+                    data.actual_iterator_end = data.actual_iterator_start;
+
+                    if (matcher::match(data))
+                    {
+                        return true;
+                    }
+
+                    data.actual_iterator_start++;
+                } while (data.actual_iterator_start < query.end()
+                         && fits_length<matcher::min_length>(data.actual_iterator_start, query.end()));
+
+                if constexpr (matcher::min_length == 0)
+                {
+                    // Only empty matches can start at the end of the query
+                    if (query.begin() < query.end())
+                    {
+                        data.actual_iterator_start = data.actual_iterator_end = query.end();
+
+                        return static_cast<bool>(matcher::match(data));
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief Checks if the regex matches the whole query
+             */
+            template<typename Query = literal_string_view<Char_Type>>
+            static constexpr auto full_match(Query query) noexcept -> bool
+            {
+                const auto size = static_cast<std::size_t>(query.size());
+
+                if (size < matcher::min_length || size > matcher::max_length)
+                {
+                    return false;
+                }
+
+                if constexpr (class_validator<matcher>::enabled
+                              && std::is_same_v<Query, literal_string_view<char>>)
+                {
+                    // Fixed shapes are validated with one table lookup per byte
+                    return class_validator<matcher>::validate(query.begin());
+                }
+
+                test_cursor<Char_Type, Query> data;
+                data.query                 = query;
+                data.actual_iterator_start = query.begin();
+                data.actual_iterator_end   = query.begin();
+
+                // The end of the query is the final continuation of every path
+                return matcher::template match<nodes::simple<terminals::anchors::end>>(data);
+            }
+    };
+}// namespace e_regex
+
+#endif /* BOOLEAN_MATCH_HPP */
@@ -0,0 +1,146 @@
+#ifndef CLASS_VALIDATOR_HPP
+#define CLASS_VALIDATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "bndm_search.hpp"
+#include "match_result.hpp"
+#include "utilities/byte_set.hpp"
+#include "utilities/literal_string_view.hpp"
+
+namespace e_regex
+{
+    // Exact sets, computed by running single character nodes on every byte
+    struct matched_classes
+    {
+            static constexpr bool ignores_empty_nodes = false;
+            static constexpr bool approximates_merges = false;
+
+            template<typename T>
+            static consteval auto of() -> byte_set
+            {
+                byte_set set;
+
+                for (unsigned c = 0; c < 256; ++c)
+                {
+                    const char data[] = {static_cast<char>(c)};
+
+                    test_cursor<char> cursor;
+                    cursor.query                 = literal_string_view<char> {data, data + 1};
+                    cursor.actual_iterator_start = data;
+                    cursor.actual_iterator_end   = data;
+
+                    if (auto result = T::match(cursor); result && result.actual_iterator_end == data + 1)
+                    {
+                        set.insert(static_cast<unsigned char>(c));
+                    }
+                }
+
+                return set;
+            }
+    };
+
+    template<std::size_t classes>
+    using class_mask_t = std::conditional_t<
+        classes <= 8,
+        std::uint8_t,
+        std::conditional_t<classes <= 16, std::uint16_t, std::conditional_t<classes <= 32, std::uint32_t, std::uint64_t>>>;
+
+    /*
+        Validator for patterns whose matches are fixed sequences of single byte classes. Every
+        byte is classified with a table holding one bit per distinct class, and compared with
+        the class expected at its position, without branches
+    */
+    template<typename matcher>
+    struct class_validator
+    {
+        private:
+            static constexpr auto classes = classes_of<matcher, matched_classes>();
+
+            struct layout
+            {
+                    std::array<byte_set, class_sequence::max_length>    distinct = {};
+                    std::array<std::size_t, class_sequence::max_length> index    = {};
+                    std::size_t                                         count    = 0;
+            };
+
+            static consteval auto build_layout() -> layout
+            {
+                layout result;
+
+                for (std::size_t i = 0; i < classes.length; ++i)
+                {
+                    std::size_t j = 0;
+                    while (j < result.count && !(result.distinct[j] == classes.sets[i]))
+                    {
+                        ++j;
+                    }
+
+                    if (j == result.count)
+                    {
+                        result.distinct[result.count++] = classes.sets[i];
+                    }
+
+                    result.index[i] = j;
+                }
+
+                return result;
+            }
+
+            static constexpr auto positions = build_layout();
+
+            using mask = class_mask_t<positions.count>;
+
+            static constexpr auto table = []() {
+                std::array<mask, 256> table = {};
+
+                for (std::size_t j = 0; j < positions.count; ++j)
+                {
+                    for (unsigned c = 0; c < table.size(); ++c)
+                    {
+                        if (positions.distinct[j].contains(static_cast<unsigned char>(c)))
+                        {
+                            table[c] |= static_cast<mask>(mask {1} << j);
+                        }
+                    }
+                }
+
+                return table;
+            }();
+
+            static constexpr auto expected = []() {
+                std::array<mask, class_sequence::max_length> expected = {};
+
+                for (std::size_t i = 0; i < classes.length; ++i)
+                {
+                    expected[i] = static_cast<mask>(mask {1} << positions.index[i]);
+                }
+
+                return expected;
+            }();
+
+        public:
+            static constexpr bool        enabled = classes.valid && classes.length >= 2;
+            static constexpr std::size_t length  = classes.length;
+
+            /**
+             * @brief Checks if the length characters from data are a match
+             */
+            static constexpr auto validate(const char* data) noexcept -> bool
+            {
+                bool accepted = true;
+
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    accepted &= (table[static_cast<unsigned char>(data[i])] & expected[i]) != 0;
+                }
+
+                return accepted;
+            }
+    };
+}// namespace e_regex
+
+#endif /* CLASS_VALIDATOR_HPP */
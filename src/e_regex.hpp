@@ -1,24 +1,118 @@
 #ifndef E_REGEX_HPP
 #define E_REGEX_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+
+#include "batch_match.hpp"
+#include "boolean_match.hpp"
+#include "line_index.hpp"
 #include "match_result.hpp"
+#include "pattern_set.hpp"
 #include "static_string.hpp"
+#include "stream_matcher.hpp"
+#include "tokenization/columns.hpp"
+#include "tokenization/hashing.hpp"
+#include "tokenization/keywords.hpp"
+#include "tokenization/lexer.hpp"
+#include "tokenization/parallel.hpp"
 #include "tokenization/prebuilt_result.hpp"
 #include "tokenization/result.hpp"
+#include "tokenization/stream.hpp"
 #include "tree_builder.hpp"
 #include "utilities/literal_string_view.hpp"
+#include "utilities/segmented_view.hpp"
 
 namespace e_regex
 {
-    template<static_string regex>
+    template<static_string regex, typename capture_policy = captures::all>
     constexpr auto match = [](literal_string_view<> expression)
     {
         using packed  = build_pack_string_t<regex>;
         using matcher = typename tree_builder<packed>::tree;
 
-        return match_result<matcher> {expression};
+        return match_result<matcher, char, capture_policy> {expression};
+    };
+
+    template<static_string regex, typename capture_policy = captures::all>
+    constexpr auto match_at = [](literal_string_view<> expression, std::size_t position)
+    {
+        using packed  = build_pack_string_t<regex>;
+        using matcher = typename tree_builder<packed>::tree;
+
+        return match_result<matcher, char, capture_policy> {expression, position, sticky};
+    };
+
+    template<static_string regex, typename capture_policy = captures::all>
+    constexpr auto search_from = [](literal_string_view<> expression, std::size_t position)
+    {
+        using packed  = build_pack_string_t<regex>;
+        using matcher = typename tree_builder<packed>::tree;
+
+        return match_result<matcher, char, capture_policy> {expression, position};
+    };
+
+    template<static_string regex>
+    constexpr auto contains = [](const auto& expression) -> bool
+    {
+        using packed  = build_pack_string_t<regex>;
+        using matcher = typename tree_builder<packed>::tree;
+
+        return boolean_match<matcher>::contains(to_query(expression));
+    };
+
+    template<static_string regex>
+    constexpr auto full_match = [](const auto& expression) -> bool
+    {
+        using packed  = build_pack_string_t<regex>;
+        using matcher = typename tree_builder<packed>::tree;
+
+        return boolean_match<matcher>::full_match(to_query(expression));
+    };
+
+    template<static_string regex>
+    constexpr auto find_all
+        = [](const auto& expression, std::span<match_span> out, std::uint32_t from = 0)
+    {
+        using packed  = build_pack_string_t<regex>;
+        using matcher = typename tree_builder<packed>::tree;
+
+        return batch_match<matcher>::find_all(to_query(expression), out, from);
     };
 
+    template<static_string regex>
+    constexpr auto for_each_match
+        = [](const auto& expression, auto&& callback, std::uint32_t from = 0)
+    {
+        using packed  = build_pack_string_t<regex>;
+        using matcher = typename tree_builder<packed>::tree;
+
+        return batch_match<matcher>::for_each(to_query(expression), callback, from);
+    };
+
+    // Bounds of the length of any match, unbounded_length if there is no upper bound
+    template<static_string regex>
+    constexpr auto min_match_length = tree_builder<build_pack_string_t<regex>>::tree::min_length;
+
+    template<static_string regex>
+    constexpr auto max_match_length = tree_builder<build_pack_string_t<regex>>::tree::max_length;
+
+    template<static_string... regexes>
+    constexpr auto set = pattern_set<typename tree_builder<build_pack_string_t<regexes>>::tree...> {};
+
+    template<static_string regex>
+    using stream_matcher = basic_stream_matcher<typename tree_builder<build_pack_string_t<regex>>::tree>;
+
+    // Token type option, tokens also carry hash_bytes of their string
+    template<typename token_type>
+    using hashed = tokenization::hashed<token_type>;
+
+    // Token type that reclassifies tokens of type category equal to words as first, first + 1...
+    template<auto category, auto first, static_string... words>
+    using keywords = tokenization::keywords<category, first, words...>;
+
     template<static_string regex, static_string separator = static_string {""}, typename token_type = void>
     constexpr auto tokenize = [](literal_string_view<> expression)
     {
@@ -28,6 +122,64 @@ namespace e_regex
         return tokenization::result<matcher, separator_matcher, token_type> {expression};
     };
 
+    // Capture-free lexer of the tokens of regex separated by separator
+    template<static_string regex, static_string separator>
+    using token_lexer = tokenization::lexer<
+        match_result<typename tree_builder<build_pack_string_t<regex>>::tree, char, captures::none>,
+        typename tree_builder<build_pack_string_t<separator>>::tree>;
+
+    /**
+     * @brief Number of tokens of expression, without building them
+     */
+    template<static_string regex, static_string separator = static_string {""}>
+    constexpr auto count_tokens = [](literal_string_view<> expression)
+    {
+        return token_lexer<regex, separator>::count(expression);
+    };
+
+    /**
+     * @brief Offset of the first character of expression that is neither a token nor a
+     * separator, std::nullopt if expression tokenizes cleanly
+     */
+    template<static_string regex, static_string separator = static_string {""}>
+    constexpr auto validate_tokens = [](literal_string_view<> expression)
+    {
+        return token_lexer<regex, separator>::validate(expression);
+    };
+
+    /**
+     * @brief Tokenizes expression into caller-provided columns, without captures
+     *
+     * @return the number of tokens written and the offset to resume from when the columns are full
+     */
+    template<static_string regex, static_string separator = static_string {""}>
+    constexpr auto tokenize_into = []<typename Type_Column>(literal_string_view<> expression,
+                                                            const tokenization::columns<Type_Column>& out,
+                                                            std::size_t from = 0)
+    {
+        using lexer = token_lexer<regex, separator>;
+
+        return tokenization::fill_columns<lexer>(expression, out, from);
+    };
+
+    /**
+     * @brief Tokenizes expression with threads workers, in columns of branch indexes,
+     * offsets and lengths. Offsets must fit in 32 bits
+     */
+    template<static_string regex, static_string separator = static_string {""}, typename Type_Column = std::uint8_t>
+    constexpr auto tokenize_parallel
+        = [](literal_string_view<> expression, std::size_t threads = std::thread::hardware_concurrency())
+    {
+        using lexer = token_lexer<regex, separator>;
+
+        return tokenization::lex_parallel<lexer, Type_Column>(expression, threads);
+    };
+
+    template<static_string regex, static_string separator = static_string {""}, typename token_type = void>
+    using stream_tokenizer = tokenization::stream<typename tree_builder<build_pack_string_t<regex>>::tree,
+                                                  typename tree_builder<build_pack_string_t<separator>>::tree,
+                                                  token_type>;
+
     template<static_string regex, static_string data, static_string separator = static_string {""}, typename token_type = void>
     using token_t = tokenization::prebuilt_result<match<regex>, match<separator>, data, token_type>;
 }// namespace e_regex
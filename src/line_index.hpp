@@ -0,0 +1,93 @@
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "utilities/literal_string_view.hpp"
+
+namespace e_regex
+{
+    // 1-based line and column, in bytes
+    struct text_position
+    {
+            std::size_t line;
+            std::size_t column;
+
+            constexpr auto operator==(const text_position& other) const noexcept -> bool = default;
+    };
+
+    /*
+        Maps offsets of a text to lines and columns. Nothing is computed until the first
+        query, and newlines are only indexed up to the furthest offset asked for, so that
+        reporting positions costs nothing when it is never needed
+    */
+    class line_index
+    {
+        private:
+            // Newlines are indexed at least this many bytes at a time
+            static constexpr std::size_t block = 4096;
+
+            literal_string_view<> text;
+
+            // Offsets of the newlines in the first scanned bytes
+            std::vector<std::size_t> newlines;
+            std::size_t              scanned = 0;
+
+            constexpr void scan_to(std::size_t offset)
+            {
+                const auto size  = static_cast<std::size_t>(text.size());
+                const auto until = std::min(size, std::max(offset, scanned + block));
+
+                const auto* position = text.begin() + scanned;
+                const auto* end      = text.begin() + until;
+
+                // memchr at runtime
+                while (const auto* found
+                       = std::char_traits<char>::find(position, static_cast<std::size_t>(end - position), '\n'))
+                {
+                    newlines.push_back(static_cast<std::size_t>(found - text.begin()));
+                    position = found + 1;
+                }
+
+                scanned = until;
+            }
+
+        public:
+            constexpr explicit line_index(literal_string_view<> text) noexcept: text {text}
+            {
+            }
+
+            /**
+             * @brief Line and column of the character at offset, in O(log n) once it has been indexed
+             */
+            constexpr auto locate(std::size_t offset) -> text_position
+            {
+                offset = std::min(offset, static_cast<std::size_t>(text.size()));
+
+                if (offset > scanned)
+                {
+                    scan_to(offset);
+                }
+
+                const auto previous = std::lower_bound(newlines.begin(), newlines.end(), offset);
+                const auto line     = static_cast<std::size_t>(previous - newlines.begin());
+                const auto start    = line == 0 ? 0 : newlines[line - 1] + 1;
+
+                return {.line = line + 1, .column = offset - start + 1};
+            }
+
+            /**
+             * @brief Line and column of the beginning of part, which must be a view on the text
+             * (e.g. a token or a match)
+             */
+            constexpr auto locate(literal_string_view<> part) -> text_position
+            {
+                return locate(static_cast<std::size_t>(part.begin() - text.begin()));
+            }
+    };
+}// namespace e_regex
+
+#endif /* LINE_INDEX_HPP */
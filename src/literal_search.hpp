@@ -0,0 +1,130 @@
+#ifndef LITERAL_SEARCH_HPP
+#define LITERAL_SEARCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "nodes/basic.hpp"
+#include "static_string.hpp"
+#include "terminals/common.hpp"
+#include "terminals/exact_matcher.hpp"
+
+namespace e_regex
+{
+    template<char... chars>
+    auto exact_chars(const terminals::exact_matcher<pack_string<chars...>>*) -> pack_string<chars...>;
+
+    // Terminals matching a fixed string, escaped characters included
+    template<typename T>
+    concept exact_terminal = requires() { exact_chars(static_cast<T*>(nullptr)); };
+
+    template<typename T>
+    using exact_chars_t = decltype(exact_chars(static_cast<T*>(nullptr)));
+
+    // Regexes without any operator, e.g. configuration strings used as patterns
+    template<typename matcher>
+    struct literal_pattern
+    {
+            static constexpr bool value = false;
+    };
+
+    template<typename... identifiers>
+        requires(sizeof...(identifiers) > 0 && (exact_terminal<terminals::terminal<identifiers>> && ...))
+    struct literal_pattern<nodes::simple<terminals::terminal<identifiers...>>>
+    {
+            static constexpr bool value = true;
+
+            using string
+                = concatenate_pack_strings_t<pack_string<>, exact_chars_t<terminals::terminal<identifiers>>...>;
+    };
+
+    template<typename child>
+    struct literal_pattern<nodes::simple<void, child>> : public literal_pattern<child>
+    {
+    };
+
+    template<typename string>
+    struct literal_needle;
+
+    template<char... chars>
+    struct literal_needle<pack_string<chars...>>
+    {
+            static constexpr std::array<char, sizeof...(chars)> data {chars...};
+            static constexpr std::string_view                    value {data.data(), data.size()};
+    };
+
+    /*
+        Finds the first occurrence of needle in [begin, end), returns end if there is none.
+        Candidates are positions where both the first and the last byte of needle match:
+        they are computed for blocks of positions with loops that the compiler vectorizes,
+        and only verified with a full comparison if the block has any
+    */
+    constexpr auto find_literal(const char* begin, const char* end, std::string_view needle) noexcept
+        -> const char*
+    {
+        if (std::is_constant_evaluated())
+        {
+            const auto found = std::string_view {begin, end}.find(needle);
+
+            return found == std::string_view::npos ? end : begin + found;
+        }
+
+        const auto size = static_cast<std::ptrdiff_t>(needle.size());
+        if (end - begin < size)
+        {
+            return end;
+        }
+
+        const char first = needle.front();
+        const char last  = needle.back();
+
+        // Candidates start before limit
+        const char* const        limit = end - size + 1;
+        constexpr std::ptrdiff_t block = 32;
+
+        for (; limit - begin >= block; begin += block)
+        {
+            std::array<unsigned char, block> candidates;
+            unsigned char                    any = 0;
+
+            for (std::ptrdiff_t i = 0; i < block; ++i)
+            {
+                candidates[i] = static_cast<unsigned char>(begin[i] == first)
+                                & static_cast<unsigned char>(begin[i + size - 1] == last);
+            }
+
+            for (auto candidate: candidates)
+            {
+                any |= candidate;
+            }
+
+            if (any == 0)
+            {
+                continue;
+            }
+
+            for (std::ptrdiff_t i = 0; i < block; ++i)
+            {
+                if (candidates[i] != 0 && std::memcmp(begin + i, needle.data(), needle.size()) == 0)
+                {
+                    return begin + i;
+                }
+            }
+        }
+
+        for (; begin < limit; ++begin)
+        {
+            if (*begin == first && std::memcmp(begin, needle.data(), needle.size()) == 0)
+            {
+                return begin;
+            }
+        }
+
+        return end;
+    }
+}// namespace e_regex
+
+#endif /* LITERAL_SEARCH_HPP */
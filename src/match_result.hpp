@@ -2,21 +2,52 @@
 #define MATCH_RESULT
 
 #include <array>
-
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "bndm_search.hpp"
+#include "literal_search.hpp"
+#include "nodes/basic.hpp"
+#include "nodes/common.hpp"
+#include "reverse_search.hpp"
+#include "utilities/byte_set.hpp"
 #include "utilities/literal_string_view.hpp"
+#include "utilities/match_length.hpp"
 
 namespace e_regex
 {
-    template<std::size_t groups, typename Char_Type>
-    struct match_result_data
+    namespace captures
     {
-            literal_string_view<Char_Type>                     query;
-            typename literal_string_view<Char_Type>::iterator  actual_iterator_start;
-            typename literal_string_view<Char_Type>::iterator  actual_iterator_end;
-            std::array<literal_string_view<Char_Type>, groups> match_groups = {};
-            bool                                               accepted     = true;
+        // Every group is recorded, default policy
+        struct all
+        {
+        };
+
+        // Only the match boundaries are tracked, groups are never touched
+        struct none
+        {
+        };
+    }// namespace captures
+
+    // Tag for matches required to start exactly at the given position (\G semantics)
+    struct sticky_t
+    {
+    };
 
-            constexpr auto operator=(bool accepted) noexcept -> match_result_data &
+    inline constexpr sticky_t sticky {};
+
+    // Query is any view whose iterators can be compared, dereferenced and incremented
+    template<typename Char_Type, typename Query = literal_string_view<Char_Type>>
+    struct match_cursor
+    {
+            Query                    query;
+            typename Query::iterator actual_iterator_start;
+            typename Query::iterator actual_iterator_end;
+            bool                     accepted = true;
+
+            constexpr auto operator=(bool accepted) noexcept -> match_cursor &
             {
                 this->accepted = accepted;
 
@@ -29,26 +60,280 @@ namespace e_regex
             }
     };
 
-    template<typename matcher, typename Char_Type = char>
+    // Cursor for boolean tests, alternatives stop at the first accepted path
+    template<typename Char_Type, typename Query = literal_string_view<Char_Type>>
+    struct test_cursor : public match_cursor<Char_Type, Query>
+    {
+            using match_cursor<Char_Type, Query>::operator=;
+
+            static constexpr bool first_accept = true;
+    };
+
+    // Cursor for incomplete inputs, remembers if an attempt depended on the end of the query
+    template<typename Char_Type>
+    struct stream_cursor : public match_cursor<Char_Type>
+    {
+            using match_cursor<Char_Type>::operator=;
+
+            bool* reached_end = nullptr;
+    };
+
+    template<std::size_t groups, typename Char_Type>
+    struct match_result_data : public match_cursor<Char_Type>
+    {
+            using match_cursor<Char_Type>::operator=;
+
+            std::array<literal_string_view<Char_Type>, groups> match_groups = {};
+    };
+
+    template<std::size_t groups, typename capture_policy, typename Char_Type>
+    struct match_state
+    {
+            using type = match_result_data<groups, Char_Type>;
+    };
+
+    template<std::size_t groups, typename Char_Type>
+    struct match_state<groups, captures::none, Char_Type>
+    {
+            using type = match_cursor<Char_Type>;
+    };
+
+    template<std::size_t groups, typename capture_policy, typename Char_Type>
+    using match_state_t = typename match_state<groups, capture_policy, Char_Type>::type;
+
+    template<typename matcher, typename Char_Type = char, typename capture_policy = captures::all>
     class match_result
     {
         public:
-            using expression = typename matcher::expression;
+            using expression   = typename matcher::expression;
+            using matcher_type = matcher;
+
+            static constexpr bool with_captures = !std::is_same_v<capture_policy, captures::none>;
+
+            static constexpr std::size_t min_length = matcher::min_length;
+            static constexpr std::size_t max_length = matcher::max_length;
+
+            static constexpr byte_set required_bytes = nodes::required_bytes_getter<matcher>::value;
 
         private:
-            match_result_data<matcher::groups, Char_Type> data;
+            using alternatives = nodes::alternatives_t<matcher>;
+
+            match_state_t<matcher::groups, capture_policy, Char_Type> data;
+            std::size_t                                               branch_index = 0;
+
+            constexpr auto fits(auto start) const noexcept -> bool
+            {
+                return fits_length<min_length>(start, data.query.end());
+            }
+
+            // A single pass over the input proves that no match exists if a required byte is missing
+            constexpr auto may_match(auto start) const noexcept -> bool
+            {
+                if constexpr (literal_pattern<matcher>::value)
+                {
+                    // The substring search is as cheap as the check
+                    return fits(start);
+                }
+                else
+                {
+                    return fits(start) && nodes::required_bytes_present<matcher>(start, data.query.end());
+                }
+            }
+
+            // Finds the first match starting at actual_iterator_start or later
+            constexpr auto search() noexcept -> bool
+            {
+                if constexpr (literal_pattern<matcher>::value && std::is_same_v<Char_Type, char>)
+                {
+                    // Plain strings are found with a substring search
+                    constexpr auto needle
+                        = literal_needle<typename literal_pattern<matcher>::string>::value;
+
+                    const auto found
+                        = find_literal(data.actual_iterator_start, data.query.end(), needle);
+
+                    data.actual_iterator_start = found;
+                    data.actual_iterator_end   = found;
+                    data.accepted              = found != data.query.end();
+
+                    if (data.accepted)
+                    {
+                        data.actual_iterator_end += needle.size();
+                    }
+
+                    return data.accepted;
+                }
+                else if constexpr (bndm_searchable<matcher> && std::is_same_v<Char_Type, char>)
+                {
+                    if (!bndm_search<matcher>(data.actual_iterator_start,
+                                              data.query.end(),
+                                              [this](auto position) { return attempt(position); }))
+                    {
+                        data.accepted = false;
+                    }
+
+                    return data.accepted;
+                }
+                else if constexpr (reverse_searchable<matcher> && std::is_same_v<Char_Type, char>)
+                {
+                    if (!reverse_search<matcher>(data.actual_iterator_start,
+                                                 data.query.end(),
+                                                 [this](auto position) { return attempt(position); }))
+                    {
+                        data.accepted = false;
+                    }
+
+                    return data.accepted;
+                }
+                else
+                {
+                    // No match can start where fewer than min_length characters remain
+                    while (data.actual_iterator_start < data.query.end() && fits(data.actual_iterator_start))
+                    {
+                        if (attempt(data.actual_iterator_start))
+                        {
+                            return true;
+                        }
+
+                        data.actual_iterator_start++;
+                    }
+
+                    if constexpr (min_length == 0)
+                    {
+                        // Only empty matches can start at the end of the query
+                        if (data.actual_iterator_start == data.query.end() && attempt(data.query.end()))
+                        {
+                            return true;
+                        }
+                    }
+
+                    data.accepted = false;
+                    return false;
+                }
+            }
+
+            // Runs the matcher on cursor, recording which top-level alternative accepted
+            constexpr auto run(auto cursor) noexcept
+            {
+                if constexpr (std::tuple_size_v<alternatives> == 1)
+                {
+                    return matcher::match(std::move(cursor));
+                }
+                else
+                {
+                    return run_alternatives(std::move(cursor),
+                                            std::make_index_sequence<std::tuple_size_v<alternatives>> {});
+                }
+            }
+
+            // Same choice as nodes::branches: the longest accepted path wins, the first one on ties
+            template<std::size_t... indexes>
+            constexpr auto run_alternatives(auto cursor, std::index_sequence<indexes...>) noexcept
+            {
+                auto best     = cursor;
+                best.accepted = false;
+
+                (
+                    [&]
+                    {
+                        auto result = std::tuple_element_t<indexes, alternatives>::match(cursor);
+
+                        if (result && (!best || best.actual_iterator_end < result.actual_iterator_end))
+                        {
+                            best         = result;
+                            branch_index = indexes;
+                        }
+                    }(),
+                    ...);
+
+                return best;
+            }
+
+            // Tries a match starting at position, keeps it if accepted
+            constexpr auto attempt(auto position) noexcept -> bool
+            {
+                if constexpr (with_captures)
+                {
+                    data.match_groups = {};
+                }
+
+                data.actual_iterator_start = position;
+                data.actual_iterator_end   = position;
+                data.accepted              = true;
+                auto result                = run(data);
+
+                if (result)
+                {
+                    data = result;
+                    return true;
+                }
+
+                return false;
+            }
 
         public:
-            constexpr match_result(literal_string_view<> query) noexcept
+            constexpr match_result(literal_string_view<> query) noexcept: match_result {query, 0}
+            {
+            }
+
+            /*
+                The search starts at offset from, the whole query is kept so that anchors
+                still refer to its boundaries
+            */
+            constexpr match_result(literal_string_view<> query, std::size_t from) noexcept
             {
-                data.query                 = query;
-                data.actual_iterator_start = query.begin();
+                data.query = query;
+
+                if (from > static_cast<std::size_t>(query.size()))
+                {
+                    data.accepted = false;
+                    return;
+                }
+
+                data.actual_iterator_start = query.begin() + from;
                 data.actual_iterator_end   = data.actual_iterator_start;
 
-                data = matcher::match(data);
+                if (!may_match(data.actual_iterator_start))
+                {
+                    data.actual_iterator_start = data.actual_iterator_end = query.end();
+                    data.accepted                                        = false;
+                    return;
+                }
+
+                // Only empty matches can start at the end of the query
+                if (data.actual_iterator_start == query.end())
+                {
+                    data = run(data);
+                    return;
+                }
+
+                search();
+            }
+
+            // Single attempt at offset at, the following matches can still be found with next()
+            constexpr match_result(literal_string_view<> query, std::size_t at, sticky_t) noexcept
+            {
+                data.query = query;
+
+                if (at > static_cast<std::size_t>(query.size()))
+                {
+                    data.accepted = false;
+                    return;
+                }
+
+                data.actual_iterator_start = query.begin() + at;
+                data.actual_iterator_end   = data.actual_iterator_start;
+
+                if (!fits(data.actual_iterator_start))
+                {
+                    data.accepted = false;
+                    return;
+                }
+
+                data = run(data);
                 if (!data)
                 {
-                    next();
+                    data.actual_iterator_end = data.actual_iterator_start;
                 }
             }
 
@@ -72,8 +357,7 @@ namespace e_regex
             template<std::size_t index>
             constexpr auto get() const noexcept
             {
-                static_assert(index <= matcher::groups,
-                              "Group index is greater than the number of groups.");
+                static_assert(index <= groups(), "Group index is greater than the number of groups.");
 
                 return get_group(index);
             }
@@ -85,7 +369,14 @@ namespace e_regex
                     return to_view();
                 }
 
-                return static_cast<std::string_view>(data.match_groups[index - 1]);
+                if constexpr (with_captures)
+                {
+                    return static_cast<std::string_view>(data.match_groups[index - 1]);
+                }
+                else
+                {
+                    return std::string_view {};
+                }
             }
 
             constexpr auto operator[](std::size_t index) const noexcept
@@ -113,9 +404,45 @@ namespace e_regex
                 return data.matches;
             }
 
+            constexpr auto query() const noexcept -> literal_string_view<Char_Type>
+            {
+                return data.query;
+            }
+
+            /**
+             * @brief Offset of the match from the beginning of the query
+             */
+            constexpr auto offset() const noexcept -> std::size_t
+            {
+                return static_cast<std::size_t>(data.actual_iterator_start - data.query.begin());
+            }
+
+            /**
+             * @brief Index of the top-level alternative that produced the match
+             */
+            constexpr auto branch() const noexcept -> std::size_t
+            {
+                return branch_index;
+            }
+
+            /**
+             * @brief Length of the match
+             */
+            constexpr auto length() const noexcept -> std::size_t
+            {
+                return static_cast<std::size_t>(data.actual_iterator_end - data.actual_iterator_start);
+            }
+
             static constexpr auto groups() noexcept
             {
-                return matcher::groups;
+                if constexpr (with_captures)
+                {
+                    return matcher::groups;
+                }
+                else
+                {
+                    return std::size_t {0};
+                }
             }
 
             /**
@@ -125,26 +452,21 @@ namespace e_regex
              */
             constexpr auto next() noexcept
             {
-                data.actual_iterator_start = data.actual_iterator_end;
-
-                while (data.actual_iterator_start < data.query.end())
+                if (data.actual_iterator_end == data.actual_iterator_start)
                 {
-                    data.match_groups        = {};
-                    data.actual_iterator_end = data.actual_iterator_start;
-                    data.accepted            = true;
-                    auto result              = matcher::match(data);
-
-                    if (result)
+                    // Empty matches must not be found twice
+                    if (data.actual_iterator_end == data.query.end())
                     {
-                        data = result;
-                        return true;
+                        data.accepted = false;
+                        return false;
                     }
 
-                    data.actual_iterator_start++;
+                    ++data.actual_iterator_end;
                 }
 
-                data.accepted = false;
-                return false;
+                data.actual_iterator_start = data.actual_iterator_end;
+
+                return search();
             }
     };
 }// namespace e_regex
@@ -152,20 +474,21 @@ namespace e_regex
 // For structured decomposition
 namespace std
 {
-    template<typename matcher>
-    struct tuple_size<e_regex::match_result<matcher>>
+    template<typename matcher, typename Char_Type, typename capture_policy>
+    struct tuple_size<e_regex::match_result<matcher, Char_Type, capture_policy>>
     {
-            static const std::size_t value = matcher::groups + 1;
+            static const std::size_t value
+                = e_regex::match_result<matcher, Char_Type, capture_policy>::groups() + 1;
     };
 
-    template<std::size_t N, typename matcher, typename Char_Type>
-    struct tuple_element<N, e_regex::match_result<matcher, Char_Type>>
+    template<std::size_t N, typename matcher, typename Char_Type, typename capture_policy>
+    struct tuple_element<N, e_regex::match_result<matcher, Char_Type, capture_policy>>
     {
             using type = std::string_view;
     };
 
-    template<std::size_t N, typename matcher>
-    auto get(e_regex::match_result<matcher> t) noexcept
+    template<std::size_t N, typename matcher, typename Char_Type, typename capture_policy>
+    auto get(e_regex::match_result<matcher, Char_Type, capture_policy> t) noexcept
     {
         return t.template get<N>();
     }
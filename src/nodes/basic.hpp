@@ -1,7 +1,9 @@
 #ifndef NODES_BASIC_HPP
 #define NODES_BASIC_HPP
 
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include "common.hpp"
 #include "get_expression.hpp"
@@ -27,17 +29,19 @@ namespace e_regex::nodes
     struct simple : public base<matcher, children...>
     {
             using expression           = typename get_expression_base<matcher, children...>::type;
-            using admitted_first_chars = typename extract_admission_set<matcher, children...>::type;
+            using admitted_first_chars
+                = typename sequence_admission_set<matcher, 1, children...>::type;
 
-            template<typename... second_layer_children>
+            template<typename... continuations>
             static constexpr auto match(auto res)
             {
                 if constexpr (!std::is_same_v<matcher, void>)
                 {
-                    res = matcher::template match<second_layer_children...>(res);
+                    // Plain terminals never backtrack, no need to pass continuations
+                    res = matcher::match(std::move(res));
                 }
 
-                return dfs<children...>(res);
+                return branches<children...>::template match<continuations...>(std::move(res));
             }
     };
 
@@ -47,19 +51,36 @@ namespace e_regex::nodes
             using expression = typename get_expression_base<child>::type;
     };
 
-    template<node_with_second_layer_children matcher, typename... children>
+    template<node_with_continuations matcher, typename... children>
     struct simple<matcher, children...> : public base<matcher, children...>
     {
             using expression           = typename get_expression_base<matcher, children...>::type;
-            using admitted_first_chars = typename matcher::admitted_first_chars;
+            using admitted_first_chars
+                = typename sequence_admission_set<matcher, 1, children...>::type;
 
-            template<typename... second_layer_children>
+            template<typename... continuations>
             static constexpr auto match(auto res)
             {
-                res = matcher::template match<second_layer_children...>(res);
-                return dfs<children...>(res);
+                return matcher::template match<branches<children...>, continuations...>(std::move(res));
             }
     };
+
+    // Top-level alternatives of a tree, a tree without alternatives is its only one
+    template<typename tree>
+    struct alternatives
+    {
+            using type = std::tuple<tree>;
+    };
+
+    template<typename... children>
+        requires(sizeof...(children) > 1)
+    struct alternatives<simple<void, children...>>
+    {
+            using type = std::tuple<children...>;
+    };
+
+    template<typename tree>
+    using alternatives_t = typename alternatives<tree>::type;
 }// namespace e_regex::nodes
 
 #endif /* NODES_BASIC_HPP */
@@ -2,8 +2,13 @@
 #define NODES_COMMON_HPP
 
 #include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
 #include "utilities/admitted_set.hpp"
+#include "utilities/byte_set.hpp"
+#include "utilities/match_length.hpp"
 #include "utilities/max.hpp"
 #include "utilities/sum.hpp"
 
@@ -32,7 +37,7 @@ namespace e_regex::nodes
     };
 
     template<typename T>
-    concept node_with_second_layer_children = requires() {
+    concept node_with_continuations = requires() {
         // template match (auto) -> auto
 
         T::template match<void, void>;
@@ -53,6 +58,35 @@ namespace e_regex::nodes
             static constexpr auto value = T::groups;
     };
 
+    template<typename T>
+    concept with_captures = requires(T t) { t.match_groups; };
+
+    template<typename T>
+    concept first_accept = requires() { requires T::first_accept; };
+
+    template<typename T>
+    concept tracks_end = requires(T t) { *t.reached_end = true; };
+
+    /*
+        Checks if the cursor is at the end of the query. Cursors that track it
+        remember that the current attempt depended on the end of the input, which is
+        not final when the input is still incomplete (e.g. streams)
+    */
+    constexpr auto end_reached(auto& match_result) noexcept -> bool
+    {
+        if (match_result.actual_iterator_end < match_result.query.end())
+        {
+            return false;
+        }
+
+        if constexpr (tracks_end<decltype(match_result)>)
+        {
+            *match_result.reached_end = true;
+        }
+
+        return true;
+    }
+
     template<typename T>
     concept has_group_index = requires(T t) { t.next_group_index; };
 
@@ -68,9 +102,187 @@ namespace e_regex::nodes
             static constexpr auto value = T::next_group_index;
     };
 
+    template<typename T>
+    struct length_getter
+    {
+            static constexpr std::size_t min_length = T::min_length;
+            static constexpr std::size_t max_length = T::max_length;
+    };
+
+    template<>
+    struct length_getter<void>
+    {
+            static constexpr std::size_t min_length = 0;
+            static constexpr std::size_t max_length = 0;
+    };
+
+    // Length bounds of a set of alternatives
+    template<typename... children>
+    struct branches_length
+    {
+            static constexpr std::size_t min_length = std::min({length_getter<children>::min_length...});
+            static constexpr std::size_t max_length = std::max({length_getter<children>::max_length...});
+    };
+
+    template<>
+    struct branches_length<>
+    {
+            static constexpr std::size_t min_length = 0;
+            static constexpr std::size_t max_length = 0;
+    };
+
+    // Length bounds of matcher repeated between repetitions_min and repetitions_max times,
+    // followed by one of children
+    template<typename matcher, std::size_t repetitions_min, std::size_t repetitions_max, typename... children>
+    struct quantified_length
+    {
+            static constexpr std::size_t min_length
+                = length_sum(length_product(length_getter<matcher>::min_length, repetitions_min),
+                             branches_length<children...>::min_length);
+            static constexpr std::size_t max_length
+                = length_sum(length_product(length_getter<matcher>::max_length, repetitions_max),
+                             branches_length<children...>::max_length);
+    };
+
+    template<typename T>
+    concept has_required_bytes = requires() { T::required_bytes; };
+
+    // Bytes that occur in every match, unknown nodes require nothing
+    template<typename T>
+    struct required_bytes_getter
+    {
+            static constexpr byte_set value {};
+    };
+
+    template<has_required_bytes T>
+    struct required_bytes_getter<T>
+    {
+            static constexpr byte_set value = T::required_bytes;
+    };
+
+    // Only bytes required by every alternative are required
+    template<typename... children>
+    struct branches_required_bytes
+    {
+            static constexpr byte_set value = (required_bytes_getter<children>::value & ...);
+    };
+
+    template<>
+    struct branches_required_bytes<>
+    {
+            static constexpr byte_set value {};
+    };
+
+    // Required bytes of matcher repeated at least repetitions_min times, followed by one of children
+    template<typename matcher, std::size_t repetitions_min, typename... children>
+    struct quantified_required_bytes
+    {
+            static constexpr byte_set value
+                = (repetitions_min > 0 ? required_bytes_getter<matcher>::value : byte_set {})
+                  | branches_required_bytes<children...>::value;
+    };
+
+    template<typename set>
+    struct admitted_bytes;
+
+    template<typename Char, Char... chars>
+    struct admitted_bytes<admitted_set<Char, chars...>>
+    {
+            static constexpr byte_set value = byte_set::of(chars...);
+    };
+
+    template<typename T>
+    concept has_alphabet = requires() { T::alphabet; };
+
+    /*
+        Bytes that can occur in a match. Admission sets only model ASCII, so bytes outside
+        of it are assumed to be matched by single character classes. Unknown nodes can
+        match anything
+    */
+    template<typename T>
+    struct alphabet_getter
+    {
+            static constexpr byte_set value = byte_set::all();
+    };
+
+    template<has_alphabet T>
+    struct alphabet_getter<T>
+    {
+            static constexpr byte_set value = T::alphabet;
+    };
+
+    template<typename T>
+        requires(!has_alphabet<T> && T::max_length == 0)
+    struct alphabet_getter<T>
+    {
+            static constexpr byte_set value {};
+    };
+
+    template<typename T>
+        requires(!has_alphabet<T> && T::min_length == 1 && T::max_length == 1)
+    struct alphabet_getter<T>
+    {
+            static constexpr byte_set value
+                = admitted_bytes<typename T::admitted_first_chars>::value | byte_set::high();
+    };
+
+    template<>
+    struct alphabet_getter<void>
+    {
+            static constexpr byte_set value {};
+    };
+
+    // Bytes a match can start with, admission sets only model ASCII
+    template<typename matcher>
+    inline constexpr byte_set first_bytes
+        = matcher::min_length == 0
+              ? byte_set::all()
+              : admitted_bytes<typename matcher::admitted_first_chars>::value | byte_set::high();
+
+    // Checks that the bytes required by matcher occur in [begin, end), at most 8 of them are checked
+    template<typename matcher>
+    constexpr auto required_bytes_present(auto begin, auto end) noexcept -> bool
+    {
+        constexpr auto required = required_bytes_getter<matcher>::value;
+
+        if constexpr (required.empty() || !std::is_same_v<decltype(begin), const char*>)
+        {
+            return true;
+        }
+        else
+        {
+            constexpr auto checked = std::min(required.size(), std::size_t {8});
+
+            return bytes_present(required.template first<checked>(), begin, end);
+        }
+    }
+
+    // Admission set of matcher repeated at least repetitions_min times and followed by one of
+    // children: children are reachable without consuming characters only if the repetitions
+    // can match an empty string
+    template<typename matcher, std::size_t repetitions_min, typename... children>
+    struct sequence_admission_set
+    {
+            using type = std::conditional_t<
+                length_product(length_getter<matcher>::min_length, repetitions_min) == 0,
+                typename extract_admission_set<matcher, children...>::type,
+                typename extract_admission_set<matcher>::type>;
+    };
+
     template<typename matcher, typename... children>
     struct base
     {
+            static constexpr std::size_t min_length
+                = quantified_length<matcher, 1, 1, children...>::min_length;
+            static constexpr std::size_t max_length
+                = quantified_length<matcher, 1, 1, children...>::max_length;
+
+            static constexpr byte_set required_bytes
+                = quantified_required_bytes<matcher, 1, children...>::value;
+
+            static constexpr byte_set alphabet
+                = (alphabet_getter<matcher>::value | ... | alphabet_getter<children>::value);
+
             static constexpr auto next_group_index
                 = max(group_index_getter<matcher>::value, group_index_getter<children>::value...);
 
@@ -78,37 +290,107 @@ namespace e_regex::nodes
                 = group_getter<matcher>::value + sum(group_getter<children>::value...);
     };
 
-    constexpr auto dfs(auto match_result) noexcept
+    /*
+        Continuation passing protocol: a node matches itself and then forwards the result to
+        the first of its continuations, handing it the remaining ones. The returned result is
+        the end of the whole path, so every continuation is evaluated once per attempt.
+    */
+    constexpr auto continue_with(auto match_result) noexcept
     {
         return match_result;
     }
 
-    template<typename Child, typename... Children>
-    constexpr auto dfs(auto match_result) noexcept
+    template<typename continuation, typename... continuations>
+    constexpr auto continue_with(auto match_result) noexcept
     {
         if (!match_result)
         {
             return match_result;
         }
 
-        if constexpr (sizeof...(Children) == 0)
-        {
-            return Child::match(std::move(match_result));
-        }
-        else
-        {
-            auto result = Child::match(match_result);
-
-            match_result = dfs<Children...>(std::move(match_result));
+        return continuation::template match<continuations...>(std::move(match_result));
+    }
 
-            if (!result || (result.actual_iterator_end < match_result.actual_iterator_end))
+    // Marks the end of a quantifier iteration, the path goes on outside of the continuations
+    struct iteration_end
+    {
+            template<typename... continuations>
+            static constexpr auto match(auto match_result) noexcept
             {
-                return match_result;
+                return continue_with<continuations...>(std::move(match_result));
             }
+    };
 
-            return result;
-        }
+    // Matches a single iteration of a quantified matcher
+    template<typename matcher>
+    constexpr auto match_iteration(auto match_result) noexcept
+    {
+        return matcher::template match<iteration_end>(std::move(match_result));
     }
+
+    // Checks if the continuations lead to the end of the whole path
+    template<typename... continuations>
+    concept completes_path
+        = sizeof...(continuations) > 0 && !(std::is_same_v<continuations, iteration_end> || ...);
+
+    // Alternatives, the longest accepted path wins
+    template<typename... children>
+    struct branches
+    {
+            template<typename... continuations>
+            static constexpr auto match(auto match_result) noexcept
+            {
+                return continue_with<continuations...>(std::move(match_result));
+            }
+    };
+
+    template<typename child, typename... children>
+    struct branches<child, children...>
+    {
+            template<typename... continuations>
+            static constexpr auto match(auto match_result) noexcept
+            {
+                if (!match_result)
+                {
+                    return match_result;
+                }
+
+                if constexpr (sizeof...(children) == 0)
+                {
+                    return child::template match<continuations...>(std::move(match_result));
+                }
+                else if constexpr (first_accept<decltype(match_result)> && completes_path<continuations...>)
+                {
+                    /*
+                        Any accepted path is enough, skip the remaining alternatives. Inside a
+                        quantifier iteration the rest of the path has not been checked yet, so the
+                        longest alternative must still win
+                    */
+                    if (auto result = child::template match<continuations...>(match_result); result)
+                    {
+                        return result;
+                    }
+
+                    return branches<children...>::template match<continuations...>(
+                        std::move(match_result));
+                }
+                else
+                {
+                    auto result = child::template match<continuations...>(match_result);
+
+                    match_result
+                        = branches<children...>::template match<continuations...>(std::move(match_result));
+
+                    if (!result
+                        || (match_result && result.actual_iterator_end < match_result.actual_iterator_end))
+                    {
+                        return match_result;
+                    }
+
+                    return result;
+                }
+            }
+    };
 }// namespace e_regex::nodes
 
 #endif /* NODES_COMMON_HPP */
@@ -48,70 +48,67 @@ namespace e_regex::nodes
             using children_expression = typename get_expression_base<void, children...>::type;
             using expression          = merge_pack_strings_t<self_expression, children_expression>;
 
-            // If matcher is optional (aka repetitions_min==0), admission set must include
-            // children too
+            static constexpr std::size_t min_length
+                = quantified_length<matcher, repetitions_min, repetitions_max, children...>::min_length;
+            static constexpr std::size_t max_length
+                = quantified_length<matcher, repetitions_min, repetitions_max, children...>::max_length;
+            static constexpr byte_set required_bytes
+                = quantified_required_bytes<matcher, repetitions_min, children...>::value;
+
+            // If matcher is optional, admission set must include children too
             using admitted_first_chars
-                = std::conditional_t<repetitions_min == 0,
-                                     typename extract_admission_set<matcher, children...>::type,
-                                     typename matcher::admitted_first_chars>;
+                = typename sequence_admission_set<matcher, repetitions_min, children...>::type;
 
-            template<typename... second_layer_children>
-            static constexpr auto recursive_match(auto result, std::size_t matches = 0)
+            template<typename... continuations>
+            static constexpr auto recursive_match(auto result, std::size_t matches = 0) -> decltype(result)
             {
-                if (result.actual_iterator_end >= result.query.end() || matches >= repetitions_max)
+                if (matches < repetitions_max && !end_reached(result))
                 {
-                    result.accepted = (repetitions_min == 0 && sizeof...(children) == 0)
-                                      && dfs<second_layer_children...>(result);
-                    return result;
-                }
+                    auto iteration = match_iteration<matcher>(result);
 
-                auto last_result = result;
-                result           = matcher::match(result);
-
-                if (result)
-                {
-                    if (auto res = recursive_match<second_layer_children...>(result, matches + 1); res)
+                    // Empty iterations can only be used to reach repetitions_min
+                    if (iteration
+                        && (iteration.actual_iterator_end != result.actual_iterator_end
+                            || matches < repetitions_min))
                     {
-                        // Recursion had success
-                        return res;
+                        if (auto res = recursive_match<continuations...>(std::move(iteration), matches + 1);
+                            res)
+                        {
+                            // Recursion had success
+                            return res;
+                        }
                     }
-
-                    // Recursion had no success, this iteration could be the acceptant one
-                    result.accepted = (matches + 1) >= repetitions_min;
-
-                    result          = dfs<children...>(result);
-                    result.accepted = dfs<second_layer_children...>(result);
-                    return result;
                 }
 
-                if constexpr (repetitions_min == 0)
+                if (matches < repetitions_min)
                 {
-                    last_result          = dfs<children...>(last_result);
-                    last_result.accepted = dfs<second_layer_children...>(last_result);
-                    return last_result;
+                    // Current iteration is not matching
+                    result = false;
+                    return result;
                 }
 
-                // Current iteration is not matching
-                return result;
+                // This iteration could be the acceptant one, continue from here
+                return branches<children...>::template match<continuations...>(std::move(result));
             }
 
-            template<typename... second_layer_children>
+            template<typename... continuations>
             static constexpr auto match(auto result)
             {
                 if constexpr (std::is_same_v<matcher, void>)
                 {
-                    return dfs<children...>(result);
+                    return branches<children...>::template match<continuations...>(std::move(result));
                 }
                 else
                 {
-                    return recursive_match<second_layer_children...>(std::move(result));
+                    return recursive_match<continuations...>(std::move(result));
                 }
             }
     };
 
     template<typename matcher, std::size_t repetitions_min, std::size_t repetitions_max, typename child>
-        requires(admitted_sets_intersection_t<typename matcher::admitted_first_chars,
-                                              typename child::admitted_first_chars>::empty)
+        requires(child::min_length > 0
+                 && admitted_sets_intersection_t<typename matcher::admitted_first_chars,
+                                                 typename child::admitted_first_chars>::empty)
     struct greedy<matcher, repetitions_min, repetitions_max, child>
         : public possessive<matcher, repetitions_min, repetitions_max, child>
     {
@@ -2,13 +2,28 @@
 #define NODES_GROUP_HPP
 
 #include <algorithm>
+#include <utility>
 
 #include "basic.hpp"
 #include "static_string.hpp"
+#include "utilities/literal_string_view.hpp"
 #include "utilities/sum.hpp"
 
 namespace e_regex::nodes
 {
+    template<auto group_index>
+    struct group_end
+    {
+            template<typename... continuations>
+            static constexpr auto match(auto result)
+            {
+                auto& group = result.match_groups[group_index];
+                group       = literal_string_view {group.begin(), result.actual_iterator_end};
+
+                return continue_with<continuations...>(std::move(result));
+            }
+    };
+
     template<typename matcher, auto group_index, typename... children>
     struct group
     {
@@ -17,28 +32,43 @@ namespace e_regex::nodes
                                              pack_string<'('>,
                                              typename get_expression_base<matcher, children...>::type,
                                              pack_string<')'>>;
-            using admitted_first_chars             = typename matcher::admitted_first_chars;
+            using admitted_first_chars
+                = typename sequence_admission_set<matcher, 1, children...>::type;
             static constexpr auto next_group_index = group_index + 1;
 
             static constexpr std::size_t groups
                 = group_getter<matcher>::value + sum(group_getter<children>::value...) + 1;
 
-            template<typename... second_layer_children>
-            static constexpr auto match(auto result)
-            {
-                auto begin = result.actual_iterator_end;
+            static constexpr std::size_t min_length
+                = quantified_length<matcher, 1, 1, children...>::min_length;
+            static constexpr std::size_t max_length
+                = quantified_length<matcher, 1, 1, children...>::max_length;
+            static constexpr byte_set required_bytes
+                = quantified_required_bytes<matcher, 1, children...>::value;
 
-                result = matcher::template match<children..., second_layer_children...>(result);
+            static constexpr byte_set alphabet
+                = (alphabet_getter<matcher>::value | ... | alphabet_getter<children>::value);
 
-                if (result)
+            template<typename... continuations>
+            static constexpr auto match(auto result)
+            {
+                if constexpr (!with_captures<decltype(result)>)
                 {
+                    // Capture-free state, the group is a plain subexpression
+                    return matcher::template match<branches<children...>, continuations...>(
+                        std::move(result));
+                }
+                else
+                {
+                    // Only the start is recorded here, the capture is closed by group_end on the
+                    // path that actually gets accepted
                     result.match_groups[group_index]
-                        = literal_string_view {begin, result.actual_iterator_end};
+                        = literal_string_view {result.actual_iterator_end, result.actual_iterator_end};
 
-                    result = dfs<children...>(result);
+                    return matcher::template match<group_end<group_index>,
+                                                   branches<children...>,
+                                                   continuations...>(std::move(result));
                 }
-
-                return result;
             }
     };
 }// namespace e_regex::nodes
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <limits>
+#include <utility>
 
 #include "basic.hpp"
 #include "utilities/number_to_pack_string.hpp"
@@ -37,57 +38,52 @@ namespace e_regex::nodes
             using children_expression = typename get_expression_base<void, children...>::type;
             using expression          = merge_pack_strings_t<self_expression, children_expression>;
 
-            // If matcher is optional (aka repetitions_min==0), admission set must include children
-            // too
+            static constexpr std::size_t min_length
+                = quantified_length<matcher, repetitions_min, repetitions_max, children...>::min_length;
+            static constexpr std::size_t max_length
+                = quantified_length<matcher, repetitions_min, repetitions_max, children...>::max_length;
+            static constexpr byte_set required_bytes
+                = quantified_required_bytes<matcher, repetitions_min, children...>::value;
+
+            // If matcher is optional, admission set must include children too
             using admitted_first_chars
-                = std::conditional_t<repetitions_min == 0,
-                                     typename extract_admission_set<matcher, children...>::type,
-                                     typename matcher::admitted_first_chars>;
+                = typename sequence_admission_set<matcher, repetitions_min, children...>::type;
 
-            template<typename... second_layer_children>
+            template<typename... continuations>
             static constexpr auto match(auto result)
             {
                 if constexpr (std::is_same_v<matcher, void>)
                 {
-                    return dfs<children...>(result);
+                    return branches<children...>::template match<continuations...>(std::move(result));
                 }
                 else
                 {
-                    std::size_t matches = 0;
-
-                    for (std::size_t i = 0; i < repetitions_min; ++i)
+                    for (std::size_t matches = 0;; ++matches)
                     {
-                        result = matcher::template match<second_layer_children...>(result);
-                        matches++;
-
-                        if (!result)
+                        if (matches >= repetitions_min)
                         {
-                            return result;
-                        }
-                    }
-
-                    while (result.actual_iterator_end < result.query.end() && matches < repetitions_max)
-                    {
-                        auto dfs_result = dfs<children...>(result);
+                            // Try to stop here first, one more iteration only if the rest fails
+                            auto res = branches<children...>::template match<continuations...>(result);
 
-                        if (!dfs_result)
-                        {
-                            result = matcher::template match<second_layer_children...>(result);
-                            matches++;
-
-                            if (!result)
+                            if (res || matches >= repetitions_max || end_reached(result))
                             {
-                                return result;
+                                return res;
                             }
                         }
-                        else
+
+                        auto iteration = match_iteration<matcher>(result);
+
+                        if (!iteration
+                            || (matches >= repetitions_min
+                                && iteration.actual_iterator_end == result.actual_iterator_end))
                         {
-                            return dfs_result;
+                            // Empty iterations would loop forever
+                            iteration = false;
+                            return iteration;
                         }
-                    }
 
-                    result.accepted = matches < repetitions_max;
-                    return result;
+                        result = std::move(iteration);
+                    }
                 }
             }
     };
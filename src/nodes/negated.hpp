@@ -15,14 +15,30 @@ namespace e_regex::nodes
             using admitted_first_chars
                 = admitted_set_complement_t<typename matcher::admitted_first_chars>;
 
-            template<typename... second_layer_children>
-            static constexpr auto match(auto result)
-            {
-                result = matcher::template match<second_layer_children...>(std::move(result));
+            static constexpr byte_set required_bytes {};
 
-                result = !static_cast<bool>(result);
+            // Single character classes are exact on ASCII
+            static constexpr byte_set alphabet = ~alphabet_getter<matcher>::value | byte_set::high();
 
-                return result;
+            template<typename... continuations>
+            static constexpr auto match(auto result)
+            {
+                if (end_reached(result))
+                {
+                    result = false;
+                    return result;
+                }
+
+                // Negated sets always consume exactly one character
+                if (matcher::match(result))
+                {
+                    result = false;
+                    return result;
+                }
+
+                result.actual_iterator_end++;
+
+                return continue_with<continuations...>(std::move(result));
             }
     };
 
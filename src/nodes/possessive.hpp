@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <limits>
+#include <utility>
 
 #include "basic.hpp"
 #include "utilities/number_to_pack_string.hpp"
@@ -37,25 +38,25 @@ namespace e_regex::nodes
             using children_expression = typename get_expression_base<void, children...>::type;
             using expression          = merge_pack_strings_t<self_expression, children_expression>;
 
-            // If matcher is optional (aka repetitions_min==0), admission set must include children
-            // too
+            static constexpr std::size_t min_length
+                = quantified_length<matcher, repetitions_min, repetitions_max, children...>::min_length;
+            static constexpr std::size_t max_length
+                = quantified_length<matcher, repetitions_min, repetitions_max, children...>::max_length;
+            static constexpr byte_set required_bytes
+                = quantified_required_bytes<matcher, repetitions_min, children...>::value;
+
+            // If matcher is optional, admission set must include children too
             using admitted_first_chars
-                = std::conditional_t<repetitions_min == 0,
-                                     typename extract_admission_set<matcher, children...>::type,
-                                     typename matcher::admitted_first_chars>;
+                = typename sequence_admission_set<matcher, repetitions_min, children...>::type;
 
-            template<typename... second_layer_children>
+            template<typename... continuations>
             static constexpr auto match(auto result)
             {
                 for (std::size_t i = 0; i < repetitions_max; ++i)
                 {
-                    auto last_result = matcher::template match<second_layer_children...>(result);
+                    auto last_result = match_iteration<matcher>(result);
 
-                    if (last_result)
-                    {
-                        result = last_result;
-                    }
-                    else
+                    if (!last_result)
                     {
                         if (i < repetitions_min)
                         {
@@ -63,12 +64,20 @@ namespace e_regex::nodes
                             return last_result;
                         }
 
-                        // Failed but repetitions_min was satisfied, run dfs
+                        // Failed but repetitions_min was satisfied, no backtracking
+                        break;
+                    }
+
+                    if (last_result.actual_iterator_end == result.actual_iterator_end && i >= repetitions_min)
+                    {
+                        // Empty iteration, nothing more can be consumed
                         break;
                     }
+
+                    result = std::move(last_result);
                 }
 
-                return dfs<children...>(result);
+                return branches<children...>::template match<continuations...>(std::move(result));
             }
     };
 
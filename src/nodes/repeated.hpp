@@ -2,6 +2,7 @@
 #define NODES_REPEATED_HPP
 
 #include <cstddef>
+#include <utility>
 
 #include "basic.hpp"
 #include "utilities/number_to_pack_string.hpp"
@@ -21,14 +22,22 @@ namespace e_regex::nodes
             using children_expression = typename get_expression_base<void, children...>::type;
             using expression          = merge_pack_strings_t<self_expression, children_expression>;
 
-            using admitted_first_chars = typename matcher::admitted_first_chars;
+            static constexpr std::size_t min_length
+                = quantified_length<matcher, repetitions, repetitions, children...>::min_length;
+            static constexpr std::size_t max_length
+                = quantified_length<matcher, repetitions, repetitions, children...>::max_length;
+            static constexpr byte_set required_bytes
+                = quantified_required_bytes<matcher, repetitions, children...>::value;
 
-            template<typename... second_layer_children>
+            using admitted_first_chars
+                = typename sequence_admission_set<matcher, repetitions, children...>::type;
+
+            template<typename... continuations>
             static constexpr auto match(auto res)
             {
                 for (std::size_t i = 0; i < repetitions; ++i)
                 {
-                    res = matcher::template match<second_layer_children...>(res);
+                    res = match_iteration<matcher>(std::move(res));
 
                     if (!res)
                     {
@@ -36,7 +45,7 @@ namespace e_regex::nodes
                     }
                 }
 
-                return dfs<children...>(res);
+                return branches<children...>::template match<continuations...>(std::move(res));
             }
     };
 }// namespace e_regex::nodes
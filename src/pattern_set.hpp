@@ -0,0 +1,229 @@
+#ifndef PATTERN_SET_HPP
+#define PATTERN_SET_HPP
+
+#include <array>
+#include <bit>
+#include <bitset>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "batch_match.hpp"
+#include "match_result.hpp"
+#include "utilities/literal_string_view.hpp"
+
+namespace e_regex
+{
+    /*
+        Matches many regexes in a single pass over the query. A table built from the
+        admission sets of the trees maps every byte to the patterns that can start with
+        it, so at each position only those patterns are tried.
+    */
+    template<typename... matchers>
+    class pattern_set
+    {
+        public:
+            static constexpr std::size_t size = sizeof...(matchers);
+
+        private:
+            using word = std::uint64_t;
+
+            static constexpr std::size_t word_bits = std::numeric_limits<word>::digits;
+            static constexpr std::size_t words     = (size + word_bits - 1) / word_bits;
+
+            using mask = std::array<word, words>;
+
+            template<typename cursor>
+            using matcher_function = cursor (*)(cursor);
+
+            template<typename cursor>
+            static constexpr std::array<matcher_function<cursor>, size> dispatch {
+                [](cursor data) { return matchers::match(data); }...};
+
+            template<typename matcher>
+            static constexpr void add_candidate(std::array<mask, 256>& table, std::size_t index)
+            {
+                const word bit = word {1} << (index % word_bits);
+
+                if constexpr (matcher::min_length == 0)
+                {
+                    // Empty matches are possible anywhere
+                    for (auto& entry: table)
+                    {
+                        entry[index / word_bits] |= bit;
+                    }
+                }
+                else
+                {
+                    for (auto c: matcher::admitted_first_chars::chars)
+                    {
+                        table[static_cast<unsigned char>(c)][index / word_bits] |= bit;
+                    }
+
+                    // Admission sets do not track bytes outside of the ASCII range, e.g. for . and
+                    // negated sets, so these are always candidates
+                    for (std::size_t c = 0x80; c < table.size(); ++c)
+                    {
+                        table[c][index / word_bits] |= bit;
+                    }
+                }
+            }
+
+            static constexpr auto candidates = []()
+            {
+                std::array<mask, 256> table {};
+                std::size_t           index = 0;
+
+                (add_candidate<matchers>(table, index++), ...);
+
+                return table;
+            }();
+
+            static constexpr auto nullable = []()
+            {
+                mask        result {};
+                std::size_t index = 0;
+
+                ((result[index / word_bits] |= matchers::min_length == 0 ? word {1} << (index % word_bits)
+                                                                          : word {0},
+                  ++index),
+                 ...);
+
+                return result;
+            }();
+
+        public:
+            /**
+             * @brief Checks which patterns match somewhere in query
+             *
+             * @return a bitset where bit n is set if the nth pattern matches
+             */
+            constexpr auto operator()(literal_string_view<> query) const noexcept -> std::bitset<size>
+            {
+                std::bitset<size> result;
+                mask              active {};
+                std::size_t       remaining = size;
+
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    active[i / word_bits] |= word {1} << (i % word_bits);
+                }
+
+                test_cursor<char> data;
+                data.query = query;
+
+                auto try_candidates = [&](auto position, const mask& current)
+                {
+                    for (std::size_t w = 0; w < words; ++w)
+                    {
+                        for (auto bits = current[w] & active[w]; bits != 0; bits &= bits - 1)
+                        {
+                            const auto index = w * word_bits + std::countr_zero(bits);
+
+                            data.actual_iterator_start = position;
+                            data.actual_iterator_end   = position;
+                            data.accepted              = true;
+
+                            if (dispatch<test_cursor<char>>[index](data))
+                            {
+                                // Already matched patterns are never tried again
+                                active[w] &= ~(word {1} << (index % word_bits));
+                                result.set(index);
+                                --remaining;
+                            }
+                        }
+                    }
+                };
+
+                for (auto position = query.begin(); position < query.end() && remaining > 0; ++position)
+                {
+                    try_candidates(position, candidates[static_cast<unsigned char>(*position)]);
+                }
+
+                // Only empty matches can start at the end of the query
+                if (remaining > 0)
+                {
+                    try_candidates(query.end(), nullable);
+                }
+
+                return result;
+            }
+
+            /**
+             * @brief Calls callback with the pattern index and the match_span of every match of
+             * every pattern, in order of starting position. Stops early if callback returns false
+             */
+            constexpr void for_each_match(literal_string_view<> query, auto&& callback) const noexcept
+            {
+                // Matches of the same pattern do not overlap
+                std::array<typename literal_string_view<>::iterator, size> resume;
+                resume.fill(query.begin());
+
+                match_cursor<char> data;
+                data.query = query;
+
+                auto try_candidates = [&](auto position, const mask& current) -> bool
+                {
+                    for (std::size_t w = 0; w < words; ++w)
+                    {
+                        for (auto bits = current[w]; bits != 0; bits &= bits - 1)
+                        {
+                            const auto index = w * word_bits + std::countr_zero(bits);
+
+                            if (position < resume[index])
+                            {
+                                continue;
+                            }
+
+                            data.actual_iterator_start = position;
+                            data.actual_iterator_end   = position;
+                            data.accepted              = true;
+
+                            auto res = dispatch<match_cursor<char>>[index](data);
+
+                            if (!res)
+                            {
+                                continue;
+                            }
+
+                            const match_span span {
+                                .offset = static_cast<std::uint32_t>(position - query.begin()),
+                                .length = static_cast<std::uint32_t>(res.actual_iterator_end - position)};
+
+                            // Nothing follows an empty match at the end of the query
+                            resume[index] = span.length == 0 && position < query.end() ? position + 1
+                                                                                       : res.actual_iterator_end;
+
+                            if constexpr (std::same_as<decltype(callback(index, span)), bool>)
+                            {
+                                if (!callback(index, span))
+                                {
+                                    return false;
+                                }
+                            }
+                            else
+                            {
+                                callback(index, span);
+                            }
+                        }
+                    }
+
+                    return true;
+                };
+
+                for (auto position = query.begin(); position < query.end(); ++position)
+                {
+                    if (!try_candidates(position, candidates[static_cast<unsigned char>(*position)]))
+                    {
+                        return;
+                    }
+                }
+
+                // Only empty matches can start at the end of the query
+                try_candidates(query.end(), nullable);
+            }
+    };
+}// namespace e_regex
+
+#endif /* PATTERN_SET_HPP */
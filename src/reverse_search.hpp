@@ -0,0 +1,195 @@
+#ifndef REVERSE_SEARCH_HPP
+#define REVERSE_SEARCH_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "literal_search.hpp"
+#include "nodes.hpp"
+#include "static_string.hpp"
+#include "utilities/byte_set.hpp"
+#include "utilities/match_length.hpp"
+
+namespace e_regex
+{
+    template<typename string>
+    struct literal_length;
+
+    template<char... chars>
+    struct literal_length<pack_string<chars...>>
+    {
+            static constexpr std::size_t value = sizeof...(chars);
+    };
+
+    // Part of a chain of nodes before a literal: its minimum length and the bytes it can contain
+    template<std::size_t min_length_, byte_set alphabet_>
+    struct chain_prefix
+    {
+            static constexpr std::size_t min_length = min_length_;
+            static constexpr byte_set    alphabet   = alphabet_;
+    };
+
+    template<typename prefix, typename matcher, std::size_t repetitions_min = 1>
+    using extend_prefix_t = chain_prefix<
+        length_sum(prefix::min_length,
+                   length_product(nodes::length_getter<matcher>::min_length, repetitions_min)),
+        prefix::alphabet | nodes::alphabet_getter<matcher>::value>;
+
+    template<typename string, typename prefix>
+    struct chain_literal
+    {
+            using type = string;
+
+            static constexpr std::size_t length            = literal_length<string>::value;
+            static constexpr std::size_t prefix_min_length = prefix::min_length;
+            static constexpr byte_set    prefix_alphabet   = prefix::alphabet;
+    };
+
+    using no_chain_literal = chain_literal<pack_string<>, chain_prefix<0, byte_set {}>>;
+
+    // Longer literals give fewer false candidates, the first one wins on ties
+    template<typename first, typename second>
+    using longest_chain_literal_t = std::conditional_t<(second::length > first::length), second, first>;
+
+    // First run of exact terminals in a terminal chain, the terminals before it extend the prefix
+    template<typename prefix, typename string, typename... identifiers>
+    struct terminals_literal
+    {
+            using type = chain_literal<string, prefix>;
+    };
+
+    template<typename prefix, typename head, typename... tail>
+        requires(!exact_terminal<terminals::terminal<head>>)
+    struct terminals_literal<prefix, pack_string<>, head, tail...>
+    {
+            using type = typename terminals_literal<extend_prefix_t<prefix, terminals::terminal<head>>,
+                                                    pack_string<>,
+                                                    tail...>::type;
+    };
+
+    template<typename prefix, typename string, typename head, typename... tail>
+        requires exact_terminal<terminals::terminal<head>>
+    struct terminals_literal<prefix, string, head, tail...>
+    {
+            using type = typename terminals_literal<
+                prefix,
+                merge_pack_strings_t<string, exact_chars_t<terminals::terminal<head>>>,
+                tail...>::type;
+    };
+
+    /*
+        Longest literal every match contains, found along a chain of nodes with a single
+        continuation each. Alternatives end the chain
+    */
+    template<typename node, typename prefix = chain_prefix<0, byte_set {}>>
+    struct inner_literal
+    {
+            using type = no_chain_literal;
+    };
+
+    template<typename... identifiers, typename prefix>
+    struct inner_literal<nodes::simple<terminals::terminal<identifiers...>>, prefix>
+    {
+            using type = typename terminals_literal<prefix, pack_string<>, identifiers...>::type;
+    };
+
+    template<typename... identifiers, typename child, typename prefix>
+    struct inner_literal<nodes::simple<terminals::terminal<identifiers...>, child>, prefix>
+    {
+            using type = longest_chain_literal_t<
+                typename terminals_literal<prefix, pack_string<>, identifiers...>::type,
+                typename inner_literal<child,
+                                       extend_prefix_t<prefix, terminals::terminal<identifiers...>>>::type>;
+    };
+
+    template<typename matcher, typename child, typename prefix>
+    struct inner_literal<nodes::simple<matcher, child>, prefix>
+        : public inner_literal<child, extend_prefix_t<prefix, matcher>>
+    {
+    };
+
+    template<typename matcher, auto group_index, typename child, typename prefix>
+    struct inner_literal<nodes::group<matcher, group_index, child>, prefix>
+        : public inner_literal<child, extend_prefix_t<prefix, matcher>>
+    {
+    };
+
+    template<typename matcher, std::size_t repetitions, typename child, typename prefix>
+    struct inner_literal<nodes::repeated<matcher, repetitions, child>, prefix>
+        : public inner_literal<child, extend_prefix_t<prefix, matcher, repetitions>>
+    {
+    };
+
+    template<typename matcher, std::size_t repetitions_min, std::size_t repetitions_max, typename child, typename prefix>
+    struct inner_literal<nodes::greedy<matcher, repetitions_min, repetitions_max, child>, prefix>
+        : public inner_literal<child, extend_prefix_t<prefix, matcher, repetitions_min>>
+    {
+    };
+
+    template<typename matcher, std::size_t repetitions_min, std::size_t repetitions_max, typename child, typename prefix>
+    struct inner_literal<nodes::lazy<matcher, repetitions_min, repetitions_max, child>, prefix>
+        : public inner_literal<child, extend_prefix_t<prefix, matcher, repetitions_min>>
+    {
+    };
+
+    template<typename matcher, std::size_t repetitions_min, std::size_t repetitions_max, typename child, typename prefix>
+    struct inner_literal<nodes::possessive<matcher, repetitions_min, repetitions_max, child>, prefix>
+        : public inner_literal<child, extend_prefix_t<prefix, matcher, repetitions_min>>
+    {
+    };
+
+    template<typename matcher>
+    using inner_literal_t = typename inner_literal<matcher>::type;
+
+    // Patterns with a literal somewhere, usually surrounded by something broad
+    template<typename matcher>
+    concept reverse_searchable = !literal_pattern<matcher>::value && inner_literal_t<matcher>::length > 0;
+
+    /*
+        Finds the leftmost match of a pattern containing a literal. The literal is searched
+        first, then the text before it is scanned backward while its bytes can belong to
+        the part of a match preceding the literal: no match can start before that point, so
+        the matcher is only tried from there up to the last start compatible with the
+        literal. attempt(position) must try a match at position and return true if it
+        succeeds
+    */
+    template<typename matcher>
+    constexpr auto reverse_search(const char* start, const char* end, auto&& attempt) noexcept -> bool
+    {
+        using literal = inner_literal_t<matcher>;
+
+        constexpr auto needle     = literal_needle<typename literal::type>::value;
+        constexpr auto prefix_min = static_cast<std::ptrdiff_t>(literal::prefix_min_length);
+        constexpr auto alphabet   = literal::prefix_alphabet;
+
+        while (end - start >= static_cast<std::ptrdiff_t>(matcher::min_length))
+        {
+            const auto occurrence = find_literal(start + prefix_min, end, needle);
+            if (occurrence == end)
+            {
+                return false;
+            }
+
+            auto first = occurrence;
+            while (first > start && alphabet.contains(static_cast<unsigned char>(first[-1])))
+            {
+                --first;
+            }
+
+            const auto last = occurrence - prefix_min;
+            for (; first <= last; ++first)
+            {
+                if (attempt(first))
+                {
+                    return true;
+                }
+            }
+
+            start = last + 1;
+        }
+
+        return false;
+    }
+}// namespace e_regex
+
+#endif /* REVERSE_SEARCH_HPP */
@@ -0,0 +1,167 @@
+#ifndef STREAM_MATCHER_HPP
+#define STREAM_MATCHER_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "match_result.hpp"
+#include "utilities/literal_string_view.hpp"
+
+namespace e_regex
+{
+    /*
+        Push-style matching of an input received in chunks. Matches are reported
+        by absolute offset as soon as more input can not change them, and only the
+        bytes from the first undecided position onwards are kept.
+    */
+    template<typename matcher, typename Char_Type = char>
+    class basic_stream_matcher
+    {
+        private:
+            std::basic_string<Char_Type> buffer;
+
+            // Absolute offset of the first buffered character
+            std::size_t buffer_offset = 0;
+
+            // Next starting position to try, relative to buffer
+            std::size_t position = 0;
+
+            constexpr auto scan(auto& callback, bool final) -> bool
+            {
+                const literal_string_view<Char_Type> query {buffer.data(), buffer.data() + buffer.size()};
+
+                bool                     reached_end = false;
+                stream_cursor<Char_Type> data;
+                data.query       = query;
+                data.reached_end = &reached_end;
+
+                const auto report = [&](std::size_t start, std::size_t length) -> bool
+                {
+                    const std::basic_string_view<Char_Type> match {buffer.data() + start, length};
+
+                    if constexpr (std::same_as<decltype(callback(buffer_offset + start, match)), bool>)
+                    {
+                        return callback(buffer_offset + start, match);
+                    }
+                    else
+                    {
+                        callback(buffer_offset + start, match);
+                        return true;
+                    }
+                };
+
+                while (position < buffer.size())
+                {
+                    if (!final && buffer.size() - position < matcher::min_length)
+                    {
+                        // Not enough input to decide anything
+                        break;
+                    }
+
+                    reached_end                = false;
+                    data.actual_iterator_start = query.begin() + position;
+                    data.actual_iterator_end   = data.actual_iterator_start;
+                    data.accepted              = true;
+
+                    auto result = matcher::match(data);
+
+                    if (reached_end && !final)
+                    {
+                        // More input could change the outcome, wait for it
+                        break;
+                    }
+
+                    if (!result)
+                    {
+                        ++position;
+                        continue;
+                    }
+
+                    const auto start  = position;
+                    const auto length = static_cast<std::size_t>(result.actual_iterator_end
+                                                                 - result.actual_iterator_start);
+
+                    // Empty matches must not be found twice
+                    position += length + (length == 0 ? 1 : 0);
+
+                    if (!report(start, length))
+                    {
+                        return false;
+                    }
+                }
+
+                if constexpr (matcher::min_length == 0)
+                {
+                    // Only empty matches can start at the end of the stream, once it is known
+                    if (final && position == buffer.size())
+                    {
+                        data.actual_iterator_start = query.end();
+                        data.actual_iterator_end   = query.end();
+                        data.accepted              = true;
+
+                        const auto start = position++;
+
+                        if (matcher::match(data))
+                        {
+                            return report(start, 0);
+                        }
+                    }
+                }
+
+                return true;
+            }
+
+            constexpr void trim()
+            {
+                // One character before position is kept, so that ^ never matches after the
+                // beginning of the stream
+                if (position > 1)
+                {
+                    const auto dropped = position - 1;
+
+                    buffer.erase(0, dropped);
+                    buffer_offset += dropped;
+                    position -= dropped;
+                }
+            }
+
+        public:
+            /**
+             * @brief Appends chunk to the stream and calls callback(offset, match) for every
+             * match that is complete. If callback returns false the scan stops, and it is resumed
+             * by the next call
+             */
+            constexpr void feed(literal_string_view<Char_Type> chunk, auto&& callback)
+            {
+                buffer.append(chunk.begin(), chunk.end());
+
+                scan(callback, false);
+                trim();
+            }
+
+            /**
+             * @brief Marks the end of the stream, reporting the remaining matches. The matcher can
+             * then be reused for a new stream
+             */
+            constexpr void finish(auto&& callback)
+            {
+                scan(callback, true);
+
+                buffer.clear();
+                buffer_offset = 0;
+                position      = 0;
+            }
+
+            /**
+             * @brief Number of characters currently kept in memory
+             */
+            constexpr auto buffered() const noexcept
+            {
+                return buffer.size();
+            }
+    };
+}// namespace e_regex
+
+#endif /* STREAM_MATCHER_HPP */
@@ -10,11 +10,15 @@ namespace e_regex::terminals::anchors
             using expression           = pack_string<'$'>;
             using admitted_first_chars = admitted_set<char>;
 
+            static constexpr std::size_t min_length = 0;
+            static constexpr std::size_t max_length = 0;
+
+            template<typename... continuations>
             static constexpr auto match(auto result)
             {
-                result = (result.actual_iterator_end == result.query.end());
+                result = nodes::end_reached(result);
 
-                return result;
+                return nodes::continue_with<continuations...>(std::move(result));
             }
     };
 }// namespace e_regex::terminals::anchors
@@ -1,8 +1,10 @@
 #ifndef TERMINALS_COMMON_HPP
 #define TERMINALS_COMMON_HPP
 
+#include <cstddef>
 #include <utility>
 
+#include "nodes/common.hpp"
 #include "static_string.hpp"
 #include "utilities/admitted_set.hpp"
 
@@ -11,17 +13,20 @@ namespace e_regex::terminals
     template<typename terminal>
     struct terminal_common
     {
-            // Template used only for compatibility with nodes
-            template<typename... second_layer_children>
+            static constexpr std::size_t min_length = 1;
+            static constexpr std::size_t max_length = 1;
+
+            // Terminals never backtrack, continuations are just forwarded
+            template<typename... continuations>
             static constexpr auto match(auto result)
             {
-                if (result.actual_iterator_end >= result.query.end())
+                if (nodes::end_reached(result))
                 {
                     result = false;
                 }
                 else if (result)
                 {
-                    return terminal::match_(result);
+                    return nodes::continue_with<continuations...>(terminal::match_(std::move(result)));
                 }
 
                 return result;
@@ -34,12 +39,22 @@ namespace e_regex::terminals
             using admitted_first_chars
                 = admitted_set_complement_t<typename terminal::admitted_first_chars>;
 
+            static constexpr std::size_t min_length = 1;
+            static constexpr std::size_t max_length = 1;
+
+            template<typename... continuations>
             static constexpr auto match(auto result)
             {
+                if (nodes::end_reached(result))
+                {
+                    result = false;
+                    return result;
+                }
+
                 result = terminal::match_(std::move(result));
                 result = !result.accepted;
 
-                return result;
+                return nodes::continue_with<continuations...>(std::move(result));
             }
     };
 
@@ -52,13 +67,25 @@ namespace e_regex::terminals
     {
             using admitted_first_chars = typename terminal<head>::admitted_first_chars;
 
+            static constexpr std::size_t min_length
+                = terminal<head>::min_length + terminal<tail...>::min_length;
+            static constexpr std::size_t max_length
+                = terminal<head>::max_length + terminal<tail...>::max_length;
+
+            static constexpr byte_set required_bytes
+                = nodes::required_bytes_getter<terminal<head>>::value
+                  | nodes::required_bytes_getter<terminal<tail...>>::value;
+            static constexpr byte_set alphabet
+                = nodes::alphabet_getter<terminal<head>>::value | nodes::alphabet_getter<terminal<tail...>>::value;
+
+            template<typename... continuations>
             static constexpr auto match(auto result)
             {
                 result = terminal<head>::match(std::move(result));
 
                 if (result)
                 {
-                    return terminal<tail...>::match(std::move(result));
+                    return terminal<tail...>::template match<continuations...>(std::move(result));
                 }
 
                 return result;
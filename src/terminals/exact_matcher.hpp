@@ -16,10 +16,22 @@ namespace e_regex::terminals
     {
             using admitted_first_chars = admitted_set<char, identifier>;
 
+            static constexpr std::size_t min_length = 1 + sizeof...(identifiers);
+            static constexpr std::size_t max_length = 1 + sizeof...(identifiers);
+
+            static constexpr byte_set required_bytes = byte_set::of(identifier, identifiers...);
+            static constexpr byte_set alphabet       = required_bytes;
+
             static constexpr auto match_(auto result)
             {
                 for (auto c: pack_string<identifier, identifiers...>::string.to_view())
                 {
+                    if (nodes::end_reached(result))
+                    {
+                        result = false;
+                        break;
+                    }
+
                     result = c == *result.actual_iterator_end;
                     result.actual_iterator_end++;
 
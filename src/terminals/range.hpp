@@ -16,7 +16,7 @@ namespace e_regex::terminals
             using expression           = pack_string<'[', start, '-', end, ']'>;
             using admitted_first_chars = admitted_set_range_t<char, start, end>;
 
-            static constexpr auto match(auto result)
+            static constexpr auto match_(auto result)
             {
                 static_assert(end >= start, "Range [a-b] must respect b >= a");
 
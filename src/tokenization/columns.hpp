@@ -0,0 +1,129 @@
+#ifndef TOKENIZATION_COLUMNS_HPP
+#define TOKENIZATION_COLUMNS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "nodes/basic.hpp"
+#include "utilities/hash.hpp"
+#include "utilities/literal_string_view.hpp"
+
+namespace e_regex::tokenization
+{
+    /*
+        Caller-provided structure of arrays for tokens. Types are the indexes of the
+        top-level branches that matched, types and hashes are only written if their
+        column is not empty
+    */
+    template<typename Type_Column = std::uint8_t>
+    struct columns
+    {
+            std::span<Type_Column>   types;
+            std::span<std::uint32_t> offsets;
+            std::span<std::uint32_t> lengths;
+            std::span<std::uint64_t> hashes = {};
+    };
+
+    // Owning structure of arrays for tokens, types are always recorded
+    template<typename Type_Column = std::uint8_t>
+    struct table
+    {
+            std::vector<Type_Column>   types;
+            std::vector<std::uint32_t> offsets;
+            std::vector<std::uint32_t> lengths;
+
+            [[nodiscard]] constexpr auto size() const noexcept
+            {
+                return offsets.size();
+            }
+
+            constexpr void push_back(std::size_t type, std::size_t offset, std::size_t length)
+            {
+                types.push_back(static_cast<Type_Column>(type));
+                offsets.push_back(static_cast<std::uint32_t>(offset));
+                lengths.push_back(static_cast<std::uint32_t>(length));
+            }
+
+            // Appends the tokens of other from index from onwards
+            constexpr void append(const table& other, std::size_t from)
+            {
+                types.insert(types.end(), other.types.begin() + from, other.types.end());
+                offsets.insert(offsets.end(), other.offsets.begin() + from, other.offsets.end());
+                lengths.insert(lengths.end(), other.lengths.begin() + from, other.lengths.end());
+            }
+    };
+
+    // Outcome of a columnar fill
+    struct fill_result
+    {
+            // Number of tokens written
+            std::size_t count = 0;
+            // Offset to resume from, the end of the last token written
+            std::size_t position = 0;
+            // True if no tokens are left after position
+            bool complete = false;
+    };
+
+    // Lexes query from offset from until the columns are full, offsets must fit in 32 bits
+    template<typename lexer, typename Type_Column>
+    constexpr auto fill_columns(literal_string_view<> query, const columns<Type_Column>& out, std::size_t from) noexcept
+        -> fill_result
+    {
+        using matcher = typename decltype(lexer::no_token(query))::matcher_type;
+
+        static_assert(std::tuple_size_v<nodes::alternatives_t<matcher>> - 1
+                          <= std::numeric_limits<Type_Column>::max(),
+                      "Type column is too narrow for the number of branches.");
+
+        const bool typed    = !out.types.empty();
+        const bool hashed   = !out.hashes.empty();
+        auto       capacity = std::min(out.offsets.size(), out.lengths.size());
+
+        if (typed)
+        {
+            capacity = std::min(capacity, out.types.size());
+        }
+
+        if (hashed)
+        {
+            capacity = std::min(capacity, out.hashes.size());
+        }
+
+        fill_result result {.position = from};
+
+        for (; result.count < capacity; ++result.count)
+        {
+            const auto token = lexer::next(query, result.position);
+
+            if (!token)
+            {
+                result.complete = true;
+                break;
+            }
+
+            if (typed)
+            {
+                out.types[result.count] = static_cast<Type_Column>(token.branch());
+            }
+
+            if (hashed)
+            {
+                // The token is still in cache
+                out.hashes[result.count] = hash_bytes(token.to_view());
+            }
+
+            out.offsets[result.count] = static_cast<std::uint32_t>(token.offset());
+            out.lengths[result.count] = static_cast<std::uint32_t>(token.length());
+            result.position           = token.offset() + token.length();
+        }
+
+        return result;
+    }
+}// namespace e_regex::tokenization
+
+#endif /* TOKENIZATION_COLUMNS_HPP */
@@ -0,0 +1,73 @@
+#ifndef TOKENIZATION_HASHING_HPP
+#define TOKENIZATION_HASHING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "keywords.hpp"
+#include "token.hpp"
+#include "utilities/hash.hpp"
+
+namespace e_regex::tokenization
+{
+    // Token type option: tokens also carry hash_bytes of their string, computed as they are lexed
+    template<typename Token_Type>
+    struct hashed
+    {
+    };
+
+    template<typename Token_Type>
+    struct token_types<hashed<Token_Type>> : public token_types<Token_Type>
+    {
+            static_assert(!std::is_same_v<Token_Type, void>, "Only typed tokens can be hashed.");
+
+            static constexpr bool hashed = true;
+    };
+
+    template<typename Token_Type>
+    concept hashes_tokens = requires() { requires token_types<Token_Type>::hashed; };
+
+    template<typename Token_Type, typename String_Type = literal_string_view<char>>
+    struct hashed_token
+    {
+            Token_Type    type;
+            String_Type   string;
+            std::uint64_t hash;
+    };
+
+    // Tokens produced for the token type given to the tokenizer
+    template<typename Token_Type, typename String_Type>
+    using lexed_token_t = std::conditional_t<hashes_tokens<Token_Type>,
+                                             hashed_token<token_type_t<Token_Type>, String_Type>,
+                                             token<token_type_t<Token_Type>, String_Type>>;
+
+    // Builds the token of string, matched by the top-level branch of index branch
+    template<typename Token_Type, typename String_Type>
+    constexpr auto make_token(std::size_t branch, String_Type string) noexcept
+        -> lexed_token_t<Token_Type, String_Type>
+    {
+        using types = token_types<Token_Type>;
+
+        if constexpr (std::is_same_v<typename types::type, void>)
+        {
+            return {string};
+        }
+        else
+        {
+            const auto type = types::classify(static_cast<typename types::type>(branch), string);
+
+            if constexpr (hashes_tokens<Token_Type>)
+            {
+                return {.type = type, .string = string, .hash = hash_bytes(string)};
+            }
+            else
+            {
+                return {.type = type, .string = string};
+            }
+        }
+    }
+}// namespace e_regex::tokenization
+
+#endif /* TOKENIZATION_HASHING_HPP */
@@ -1,45 +1,35 @@
 #ifndef TOKENIZATION_RUNTIME_ITERATOR_HPP
 #define TOKENIZATION_RUNTIME_ITERATOR_HPP
 
+#include <cstddef>
 #include <type_traits>
 
+#include "hashing.hpp"
+#include "lexer.hpp"
 #include "utilities/literal_string_view.hpp"
 
 namespace e_regex::tokenization
 {
+    // Tokens of a query, lexed one at a time
     template<typename match_result, typename token_type, typename token_raw_type, auto separator_verifier>
     class iterator
     {
         private:
+            using separator_matcher = typename decltype(separator_verifier(
+                std::declval<literal_string_view<>>()))::matcher_type;
+            using lexer             = tokenization::lexer<match_result, separator_matcher>;
+
             match_result res;
             token_type   current;
 
             [[nodiscard]] static constexpr auto build_token(const match_result& res) noexcept
             {
-                if constexpr (std::is_same_v<token_raw_type, void>)
-                {
-                    // void token type, no need to match a group
-                    return decltype(current) {res.to_view()};
-                }
-                else
-                {
-                    std::size_t index = 1;
-
-                    for (; index <= match_result::groups(); ++index)
-                    {
-                        if (!res[index].empty())
-                        {
-                            break;
-                        }
-                    }
-
-                    return decltype(current) {.type   = static_cast<token_raw_type>(index - 1),
-                                              .string = res.to_view()};
-                }
+                return make_token<token_raw_type, literal_string_view<>>(res.branch(), res.to_view());
             }
 
         public:
-            constexpr explicit iterator(match_result res): res {res}, current {build_token(res)}
+            constexpr explicit iterator(literal_string_view<> query)
+                : res {lexer::next(query, 0)}, current {build_token(res)}
             {
             }
 
@@ -51,22 +41,10 @@ namespace e_regex::tokenization
 
             constexpr auto operator++() noexcept -> iterator&
             {
-                auto last = res.to_view();
-
-                res.next();
-                current = build_token(res);
-
-                if (current.string.begin() != last.end())
+                if (*this)
                 {
-                    // Non-consecutive tokens, possible syntax error
-                    literal_string_view separator {last.end(), current.string.begin()};
-
-                    if (!separator_verifier(separator).is_accepted())
-                    {
-                        // Separator is not accepted from the given separator matcher,
-                        // syntax error found!
-                        invalidate();
-                    }
+                    res     = lexer::next(res.query(), res.offset() + res.length());
+                    current = build_token(res);
                 }
 
                 return *this;
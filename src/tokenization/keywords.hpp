@@ -0,0 +1,186 @@
+#ifndef TOKENIZATION_KEYWORDS_HPP
+#define TOKENIZATION_KEYWORDS_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "static_string.hpp"
+
+namespace e_regex::tokenization
+{
+    // Perfect hash of a set of words, its parameters are found at compile time
+    struct perfect_hash
+    {
+            bool found = false;
+
+            // Every byte is hashed, instead of the length and three bytes
+            bool full = false;
+
+            std::uint32_t seed = 0;
+            std::size_t   bits = 0;
+
+            [[nodiscard]] constexpr auto operator()(std::string_view word) const noexcept -> std::size_t
+            {
+                std::uint32_t key = 0;
+
+                if (full)
+                {
+                    // FNV-1a
+                    key = 2166136261U;
+                    for (const auto c: word)
+                    {
+                        key = (key ^ static_cast<unsigned char>(c)) * 16777619U;
+                    }
+                }
+                else if (!word.empty())
+                {
+                    key = static_cast<std::uint32_t>(word.size() & 0xFF)
+                          | static_cast<std::uint32_t>(static_cast<unsigned char>(word.front())) << 8
+                          | static_cast<std::uint32_t>(static_cast<unsigned char>(word[word.size() / 2])) << 16
+                          | static_cast<std::uint32_t>(static_cast<unsigned char>(word.back())) << 24;
+                }
+
+                if (bits == 0)
+                {
+                    return 0;
+                }
+
+                return (key * seed) >> (32 - bits);
+            }
+    };
+
+    // Searches a multiplicative hash without collisions, trying the cheap key first
+    template<std::size_t count>
+    consteval auto find_perfect_hash(const std::array<std::string_view, count>& words) -> perfect_hash
+    {
+        std::size_t min_bits = 0;
+        while ((std::size_t {1} << min_bits) < count)
+        {
+            ++min_bits;
+        }
+
+        for (const auto full: {false, true})
+        {
+            for (auto bits = min_bits; bits <= min_bits + 3 && bits <= 16; ++bits)
+            {
+                std::uint32_t state = 0x9E3779B9U;
+
+                for (std::size_t attempt = 0; attempt < 4096; ++attempt)
+                {
+                    state = state * 1664525U + 1013904223U;
+
+                    const perfect_hash hash {.found = true, .full = full, .seed = state | 1U, .bits = bits};
+
+                    bool collision = false;
+                    for (std::size_t i = 0; i < count && !collision; ++i)
+                    {
+                        for (std::size_t j = i + 1; j < count && !collision; ++j)
+                        {
+                            collision = hash(words[i]) == hash(words[j]);
+                        }
+                    }
+
+                    if (!collision)
+                    {
+                        return hash;
+                    }
+                }
+            }
+        }
+
+        return {};
+    }
+
+    /*
+        Reclassifies tokens of type category that are one of words: the i-th word gets type
+        first + i. A token is looked up with one hash and one comparison
+    */
+    template<auto category, auto first, static_string... words>
+    struct keywords
+    {
+            using type = decltype(category);
+
+            static_assert(std::is_same_v<decltype(first), type>, "Keyword types must belong to the token type.");
+            static_assert(sizeof...(words) > 0, "At least one keyword is required.");
+
+        private:
+            static constexpr std::array<std::string_view, sizeof...(words)> table {
+                std::string_view {words.data.data(), words.size}...};
+
+            static constexpr auto hash = find_perfect_hash(table);
+
+            static_assert(hash.found, "Keywords must be distinct.");
+
+            static consteval auto build_slots()
+            {
+                // Index of the word plus one, 0 for empty slots
+                std::array<std::size_t, std::size_t {1} << hash.bits> slots {};
+
+                for (std::size_t i = 0; i < table.size(); ++i)
+                {
+                    slots[hash(table[i])] = i + 1;
+                }
+
+                return slots;
+            }
+
+            static constexpr auto slots = build_slots();
+
+        public:
+            [[nodiscard]] static constexpr auto classify(type token_type, std::string_view string) noexcept -> type
+            {
+                if (token_type != category)
+                {
+                    return token_type;
+                }
+
+                const auto slot = slots[hash(string)];
+
+                if (slot == 0 || table[slot - 1] != string)
+                {
+                    return token_type;
+                }
+
+                using underlying = std::underlying_type_t<type>;
+
+                return static_cast<type>(static_cast<underlying>(first) + static_cast<underlying>(slot - 1));
+            }
+    };
+
+    template<typename T>
+    concept token_classifier = requires(typename T::type type, std::string_view string) {
+        { T::classify(type, string) } -> std::same_as<typename T::type>;
+    };
+
+    // Types of tokens, as given to the tokenizer or as classified by keywords
+    template<typename Token_Type>
+    struct token_types
+    {
+            using type = Token_Type;
+
+            static constexpr auto classify(type token_type, std::string_view /*unused*/) noexcept -> type
+            {
+                return token_type;
+            }
+    };
+
+    template<>
+    struct token_types<void>
+    {
+            using type = void;
+    };
+
+    template<token_classifier Token_Type>
+    struct token_types<Token_Type> : public Token_Type
+    {
+    };
+
+    template<typename Token_Type>
+    using token_type_t = typename token_types<Token_Type>::type;
+}// namespace e_regex::tokenization
+
+#endif /* TOKENIZATION_KEYWORDS_HPP */
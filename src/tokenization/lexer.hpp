@@ -0,0 +1,232 @@
+#ifndef TOKENIZATION_LEXER_HPP
+#define TOKENIZATION_LEXER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+#include "class_validator.hpp"
+#include "match_result.hpp"
+#include "nodes.hpp"
+#include "nodes/common.hpp"
+#include "utilities/byte_set.hpp"
+#include "utilities/literal_string_view.hpp"
+
+namespace e_regex::tokenization
+{
+    template<typename T>
+    consteval auto single_class() -> byte_set
+    {
+        constexpr auto classes = classes_of<T, matched_classes>();
+
+        if constexpr (classes.valid && classes.length == 1)
+        {
+            return classes.sets[0];
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    template<typename T>
+    consteval auto run_class_of(const void* /*unused*/) -> byte_set
+    {
+        return single_class<T>();
+    }
+
+    template<typename T, typename matcher, std::size_t repetitions_min, std::size_t repetitions_max>
+    consteval auto run_class_of(const nodes::greedy<matcher, repetitions_min, repetitions_max>* /*unused*/)
+        -> byte_set
+    {
+        return repetitions_min <= 1 && repetitions_max >= 1 ? single_class<matcher>() : byte_set {};
+    }
+
+    template<typename T, typename matcher, std::size_t repetitions_min, std::size_t repetitions_max>
+    consteval auto run_class_of(const nodes::possessive<matcher, repetitions_min, repetitions_max>* /*unused*/)
+        -> byte_set
+    {
+        return repetitions_min <= 1 && repetitions_max >= 1 ? single_class<matcher>() : byte_set {};
+    }
+
+    template<typename T, typename matcher, std::size_t repetitions_min, std::size_t repetitions_max>
+    consteval auto run_class_of(const nodes::lazy<matcher, repetitions_min, repetitions_max>* /*unused*/)
+        -> byte_set
+    {
+        return repetitions_min == 1 && repetitions_max >= 1 ? single_class<matcher>() : byte_set {};
+    }
+
+    /*
+        Bytes that are a separator on their own, for separators made of one byte class or of
+        a repetition of it (e.g. \s, \s+). A run of them is matched by separators only
+    */
+    template<typename T>
+    inline constexpr byte_set run_class = run_class_of<T>(static_cast<const T*>(nullptr));
+
+    /*
+        Single pass lexer: at each position the first byte selects, through compile-time
+        tables, whether a token or a separator can start there, and the candidates are
+        matched anchored at the position. The longest one wins, tokens win ties. Anything
+        else is a syntax error and ends the input
+    */
+    template<typename token_result, typename separator_matcher>
+    struct lexer
+    {
+        private:
+            using token_matcher    = typename token_result::matcher_type;
+            using separator_result = match_result<separator_matcher, char, captures::none>;
+
+            static constexpr auto token_first_bytes     = nodes::first_bytes<token_matcher>;
+            static constexpr auto separator_first_bytes = nodes::first_bytes<separator_matcher>;
+
+            // Separator bytes that can not start a token, runs of them can be skipped at once
+            static constexpr auto skipped_bytes
+                = (run_class<separator_matcher> & token_first_bytes).empty() ? run_class<separator_matcher>
+                                                                             : byte_set {};
+
+            static constexpr auto skip(literal_string_view<> query, std::size_t position) noexcept -> std::size_t
+            {
+                const auto* begin = query.begin() + position;
+
+                if constexpr (skipped_bytes.size() <= 8)
+                {
+                    if (!std::is_constant_evaluated())
+                    {
+                        return static_cast<std::size_t>(
+                            skip_bytes(skipped_bytes.template first<skipped_bytes.size()>(), begin, query.end())
+                            - query.begin());
+                    }
+                }
+
+                while (begin < query.end() && skipped_bytes.contains(static_cast<unsigned char>(*begin)))
+                {
+                    ++begin;
+                }
+
+                return static_cast<std::size_t>(begin - query.begin());
+            }
+
+        public:
+            // Finds the token at position, after any separator
+            [[nodiscard]] static constexpr auto next(literal_string_view<> query, std::size_t position) noexcept
+                -> token_result
+            {
+                return scan(query, position);
+            }
+
+            /*
+                Same as next, position is moved to the beginning of the token or, if there is
+                none, to the end of the query or to the syntax error
+            */
+            [[nodiscard]] static constexpr auto scan(literal_string_view<> query, std::size_t& position) noexcept
+                -> token_result
+            {
+                const auto size = static_cast<std::size_t>(query.size());
+
+                while (position < size)
+                {
+                    const auto c = static_cast<unsigned char>(query.begin()[position]);
+
+                    if constexpr (!skipped_bytes.empty())
+                    {
+                        if (skipped_bytes.contains(c))
+                        {
+                            position = skip(query, position);
+                            continue;
+                        }
+                    }
+
+                    const auto token = token_first_bytes.contains(c) ? token_result {query, position, sticky}
+                                                                     : no_token(query);
+
+                    std::size_t separator_length = 0;
+                    if (separator_first_bytes.contains(c))
+                    {
+                        if (const separator_result separator {query, position, sticky}; separator)
+                        {
+                            separator_length = separator.length();
+                        }
+                    }
+
+                    if (token && token.length() > 0 && token.length() >= separator_length)
+                    {
+                        return token;
+                    }
+
+                    if (separator_length == 0)
+                    {
+                        // Syntax error
+                        break;
+                    }
+
+                    position += separator_length;
+                }
+
+                return no_token(query);
+            }
+
+            // Number of tokens of query
+            [[nodiscard]] static constexpr auto count(literal_string_view<> query) noexcept -> std::size_t
+            {
+                std::size_t result   = 0;
+                std::size_t position = 0;
+
+                while (const auto token = scan(query, position))
+                {
+                    ++result;
+                    position += token.length();
+                }
+
+                return result;
+            }
+
+            // Offset of the first syntax error of query, if any
+            [[nodiscard]] static constexpr auto validate(literal_string_view<> query) noexcept
+                -> std::optional<std::size_t>
+            {
+                std::size_t position = 0;
+
+                while (const auto token = scan(query, position))
+                {
+                    position += token.length();
+                }
+
+                if (position < static_cast<std::size_t>(query.size()))
+                {
+                    return position;
+                }
+
+                return std::nullopt;
+            }
+
+            // First position in [from, to) that follows a separator, to if there is none
+            [[nodiscard]] static constexpr auto resync(literal_string_view<> query, std::size_t from, std::size_t to) noexcept
+                -> std::size_t
+            {
+                for (auto position = from; position < to; ++position)
+                {
+                    if (!separator_first_bytes.contains(static_cast<unsigned char>(query.begin()[position])))
+                    {
+                        continue;
+                    }
+
+                    if (const separator_result separator {query, position, sticky};
+                        separator && separator.length() > 0)
+                    {
+                        return std::min(position + separator.length(), to);
+                    }
+                }
+
+                return to;
+            }
+
+            [[nodiscard]] static constexpr auto no_token(literal_string_view<> query) noexcept -> token_result
+            {
+                // Attempts past the end are never accepted
+                return token_result {query, static_cast<std::size_t>(query.size()) + 1, sticky};
+            }
+    };
+}// namespace e_regex::tokenization
+
+#endif /* TOKENIZATION_LEXER_HPP */
@@ -0,0 +1,132 @@
+#ifndef TOKENIZATION_PARALLEL_HPP
+#define TOKENIZATION_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "columns.hpp"
+#include "nodes/basic.hpp"
+#include "utilities/literal_string_view.hpp"
+
+namespace e_regex::tokenization
+{
+    // Tokens lexed speculatively from the start of a chunk
+    template<typename Type_Column>
+    struct chunk_tokens
+    {
+            table<Type_Column> tokens;
+
+            // Position reached by the lexer after the last token
+            std::size_t stop = 0;
+    };
+
+    // Lexes the tokens starting in [begin, end)
+    template<typename lexer, typename Type_Column>
+    auto lex_chunk(literal_string_view<> query, std::size_t begin, std::size_t end) -> chunk_tokens<Type_Column>
+    {
+        chunk_tokens<Type_Column> chunk {.tokens = {}, .stop = begin};
+
+        while (true)
+        {
+            const auto token = lexer::next(query, chunk.stop);
+
+            if (!token || token.offset() >= end)
+            {
+                return chunk;
+            }
+
+            chunk.tokens.push_back(token.branch(), token.offset(), token.length());
+            chunk.stop = token.offset() + token.length();
+        }
+    }
+
+    /*
+        Every thread lexes a chunk starting right after a separator, which is only a guess of
+        where a token can start. The chunks are then stitched by the sequential lexer: since it
+        has no state other than its position, a chunk is reused from the first token it shares
+        with the sequential one, and the tokens before it are lexed again
+    */
+    template<typename lexer, typename Type_Column>
+    auto lex_parallel(literal_string_view<> query, std::size_t threads) -> table<Type_Column>
+    {
+        using matcher = typename decltype(lexer::no_token(query))::matcher_type;
+
+        static_assert(std::tuple_size_v<nodes::alternatives_t<matcher>> - 1
+                          <= std::numeric_limits<Type_Column>::max(),
+                      "Type column is too narrow for the number of branches.");
+
+        const auto size = static_cast<std::size_t>(query.size());
+
+        threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(size, 1));
+
+        std::vector<std::size_t> bounds {0};
+        for (std::size_t i = 1; i < threads; ++i)
+        {
+            const auto nominal = std::max(size / threads * i, bounds.back());
+            bounds.push_back(lexer::resync(query, nominal, size));
+        }
+        bounds.push_back(size);
+
+        std::vector<chunk_tokens<Type_Column>> chunks(threads);
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(threads - 1);
+
+            for (std::size_t i = 1; i < threads; ++i)
+            {
+                workers.emplace_back(
+                    [&, i]
+                    { chunks[i] = lex_chunk<lexer, Type_Column>(query, bounds[i], bounds[i + 1]); });
+            }
+
+            chunks[0] = lex_chunk<lexer, Type_Column>(query, bounds[0], bounds[1]);
+        }
+
+        table<Type_Column> result = std::move(chunks[0].tokens);
+        std::size_t        position = chunks[0].stop;
+
+        for (std::size_t i = 1; i < threads; ++i)
+        {
+            const auto& chunk = chunks[i];
+
+            while (true)
+            {
+                const auto token = lexer::next(query, position);
+
+                if (!token)
+                {
+                    return result;
+                }
+
+                if (token.offset() >= bounds[i + 1])
+                {
+                    break;
+                }
+
+                const auto shared = std::lower_bound(chunk.tokens.offsets.begin(),
+                                                     chunk.tokens.offsets.end(),
+                                                     token.offset());
+
+                if (shared != chunk.tokens.offsets.end() && *shared == token.offset())
+                {
+                    // The guess was right from here on
+                    result.append(chunk.tokens,
+                                  static_cast<std::size_t>(shared - chunk.tokens.offsets.begin()));
+                    position = chunk.stop;
+                    break;
+                }
+
+                result.push_back(token.branch(), token.offset(), token.length());
+                position = token.offset() + token.length();
+            }
+        }
+
+        return result;
+    }
+}// namespace e_regex::tokenization
+
+#endif /* TOKENIZATION_PARALLEL_HPP */
@@ -1,6 +1,7 @@
 #ifndef TOKENIZATION_PREBUILT_RESULT_HPP
 #define TOKENIZATION_PREBUILT_RESULT_HPP
 
+#include "keywords.hpp"
 #include "result.hpp"
 #include "static_string.hpp"
 #include "token.hpp"
@@ -31,10 +32,10 @@ namespace e_regex::tokenization
             static constexpr auto token_static_string
                 = to_static_string<token_string.size()>(token_string);
 
-            static constexpr auto token {build_token<Token_Type, token_static_string>(token_data)};
+            static constexpr auto token {build_token<token_type_t<Token_Type>, token_static_string>(token_data)};
 
             using tokens =
-                typename merge_tokens<token_container<Token_Type, token>,
+                typename merge_tokens<token_container<token_type_t<Token_Type>, token>,
                                       typename prebuilt_result<matcher,
                                                                separator_matcher,
                                                                string.template substring<token_end>(),
@@ -45,7 +46,7 @@ namespace e_regex::tokenization
         requires(string.empty())
     struct prebuilt_result<matcher, separator_matcher, string, Token_Type>
     {
-            using tokens = token_container<Token_Type>;
+            using tokens = token_container<token_type_t<Token_Type>>;
     };
 }// namespace e_regex::tokenization
 
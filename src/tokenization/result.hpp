@@ -1,14 +1,18 @@
 #ifndef TOKENIZATION_RESULT_HPP
 #define TOKENIZATION_RESULT_HPP
 
+#include "hashing.hpp"
 #include "iterator.hpp"
+#include "lexer.hpp"
+#include "line_index.hpp"
 #include "token.hpp"
 #include "utilities/literal_string_view.hpp"
 
 namespace e_regex::tokenization
 {
-    // If Token_Type is an enum, it MUST contain at least the number of groups of regex of
-    // consecutive values starting from 0
+    // If Token_Type is an enum, it MUST contain at least the number of branches of regex of
+    // consecutive values starting from 0. It can also be a keywords table of such an enum, or
+    // either of them wrapped in hashed
     template<auto matcher, auto separator_verifier, typename Token_Type_, typename Char_Type = char>
     class result
     {
@@ -16,41 +20,46 @@ namespace e_regex::tokenization
             using match_result = decltype(matcher(std::declval<literal_string_view<>>()));
 
         public:
-            using token_type = token<Token_Type_, literal_string_view<Char_Type>>;
+            using token_type = lexed_token_t<Token_Type_, literal_string_view<Char_Type>>;
             using iter       = iterator<match_result, token_type, Token_Type_, separator_verifier>;
 
         private:
-            match_result regex_result;
+            literal_string_view<> expression;
 
         public:
-            constexpr explicit result(literal_string_view<> expression)
-                : regex_result {matcher(expression)} {};
+            constexpr explicit result(literal_string_view<> expression): expression {expression} {};
 
             constexpr auto begin() const noexcept -> iter
             {
-                return iter {regex_result};
+                return iter {expression};
             }
 
             constexpr auto end() const noexcept -> iter
             {
-                iter res {regex_result};
+                iter res {literal_string_view<> {}};
                 res.invalidate();
 
                 return res;
             }
 
-            constexpr auto count() const noexcept
+            /**
+             * @brief Lazy map from tokens to their lines and columns
+             */
+            constexpr auto lines() const noexcept
             {
-                std::size_t result = 0;
-                auto        i      = begin();
+                return line_index {expression};
+            }
 
-                while (i)
-                {
-                    ++result;
-                    ++i;
-                }
+            constexpr auto count() const noexcept
+            {
+                // Tokens are only counted, captures and types are not needed
+                using separator_matcher
+                    = typename decltype(separator_verifier(std::declval<literal_string_view<>>()))::matcher_type;
+                using lexer = tokenization::lexer<
+                    e_regex::match_result<typename match_result::matcher_type, char, captures::none>,
+                    separator_matcher>;
 
-                return result;
+                return lexer::count(expression);
             }
     };
 }// namespace e_regex::tokenization
@@ -0,0 +1,258 @@
+#ifndef TOKENIZATION_STREAM_HPP
+#define TOKENIZATION_STREAM_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "hashing.hpp"
+#include "match_result.hpp"
+#include "nodes/common.hpp"
+#include "utilities/literal_string_view.hpp"
+
+namespace e_regex::tokenization
+{
+    /*
+        Push-style tokenization of an input received in chunks, with the rules of lexer.
+        A token is reported by absolute offset as soon as more input can not change it,
+        and only the bytes from the first undecided position onwards are kept.
+    */
+    template<typename token_matcher, typename separator_matcher, typename Token_Type>
+    class stream
+    {
+        private:
+            using alternatives = nodes::alternatives_t<token_matcher>;
+
+            static constexpr auto token_first_bytes     = nodes::first_bytes<token_matcher>;
+            static constexpr auto separator_first_bytes = nodes::first_bytes<separator_matcher>;
+
+            std::string buffer;
+
+            // Absolute offset of the first buffered character
+            std::size_t buffer_offset = 0;
+
+            // Next position to lex, relative to buffer
+            std::size_t position = 0;
+
+            std::optional<std::size_t> error;
+
+            // Length of the match of node anchored at position, 0 if there is none
+            template<typename node>
+            constexpr auto attempt(literal_string_view<> query, bool& reached_end) const noexcept -> std::size_t
+            {
+                stream_cursor<char> data;
+                data.query                 = query;
+                data.reached_end           = &reached_end;
+                data.actual_iterator_start = query.begin() + position;
+                data.actual_iterator_end   = data.actual_iterator_start;
+
+                const auto result = node::match(data);
+
+                if (!result)
+                {
+                    return 0;
+                }
+
+                return static_cast<std::size_t>(result.actual_iterator_end - result.actual_iterator_start);
+            }
+
+            struct token_match
+            {
+                    std::size_t length = 0;
+                    std::size_t branch = 0;
+            };
+
+            /*
+                Token anchored at position. Typed tokens try the top-level alternatives one by
+                one, with the choice of match_result: the longest wins, the first one on ties
+            */
+            constexpr auto attempt_token(literal_string_view<> query, bool& reached_end) const noexcept
+                -> token_match
+            {
+                if constexpr (std::is_same_v<Token_Type, void>)
+                {
+                    return {.length = attempt<token_matcher>(query, reached_end)};
+                }
+                else
+                {
+                    return [&]<std::size_t... indexes>(std::index_sequence<indexes...>)
+                    {
+                        token_match best;
+
+                        (
+                            [&]
+                            {
+                                const auto length
+                                    = attempt<std::tuple_element_t<indexes, alternatives>>(query, reached_end);
+
+                                if (length > best.length)
+                                {
+                                    best = {.length = length, .branch = indexes};
+                                }
+                            }(),
+                            ...);
+
+                        return best;
+                    }(std::make_index_sequence<std::tuple_size_v<alternatives>> {});
+                }
+            }
+
+            constexpr auto report(token_match token, auto& callback) const
+            {
+                const std::string_view string {buffer.data() + position, token.length};
+
+                if constexpr (std::is_same_v<Token_Type, void>)
+                {
+                    return callback(buffer_offset + position, string);
+                }
+                else
+                {
+                    return callback(buffer_offset + position,
+                                    make_token<Token_Type, std::string_view>(token.branch, string));
+                }
+            }
+
+            constexpr auto scan(auto& callback, bool final) -> bool
+            {
+                const literal_string_view<> query {buffer.data(), buffer.data() + buffer.size()};
+
+                while (!error && position < buffer.size())
+                {
+                    const auto c = static_cast<unsigned char>(buffer[position]);
+
+                    bool        reached_end      = false;
+                    token_match token;
+                    std::size_t separator_length = 0;
+
+                    if (token_first_bytes.contains(c))
+                    {
+                        // The branch of the match is kept for typed tokens
+                        token = attempt_token(query, reached_end);
+                    }
+
+                    if (separator_first_bytes.contains(c))
+                    {
+                        separator_length = attempt<separator_matcher>(query, reached_end);
+                    }
+
+                    if (reached_end && !final)
+                    {
+                        // More input could change the outcome, wait for it
+                        break;
+                    }
+
+                    if (token.length > 0 && token.length >= separator_length)
+                    {
+                        const auto start = position;
+
+                        if constexpr (std::same_as<decltype(report(token, callback)), bool>)
+                        {
+                            if (!report(token, callback))
+                            {
+                                position = start + token.length;
+                                return false;
+                            }
+                        }
+                        else
+                        {
+                            report(token, callback);
+                        }
+
+                        position = start + token.length;
+                    }
+                    else if (separator_length > 0)
+                    {
+                        position += separator_length;
+                    }
+                    else
+                    {
+                        // Syntax error, the rest of the stream is ignored
+                        error = buffer_offset + position;
+                    }
+                }
+
+                return true;
+            }
+
+            constexpr void trim()
+            {
+                // One character before position is kept, so that ^ never matches after the
+                // beginning of the stream
+                if (position > 1)
+                {
+                    const auto dropped = position - 1;
+
+                    buffer.erase(0, dropped);
+                    buffer_offset += dropped;
+                    position -= dropped;
+                }
+            }
+
+        public:
+            /**
+             * @brief Appends chunk to the stream and calls callback(offset, token) for every
+             * token that is complete. If callback returns false the scan stops, and it is resumed
+             * by the next call
+             */
+            constexpr void feed(literal_string_view<> chunk, auto&& callback)
+            {
+                if (error)
+                {
+                    return;
+                }
+
+                buffer.append(chunk.begin(), chunk.end());
+
+                scan(callback, false);
+                trim();
+            }
+
+            /**
+             * @brief Marks the end of the stream, reporting the remaining tokens. The tokenizer
+             * can then be reused for a new stream. If callback returns false the tokens left are
+             * kept, and they are reported by the next call
+             *
+             * @return the offset of the first character that is neither a token nor a separator, if any
+             */
+            constexpr auto finish(auto&& callback) -> std::optional<std::size_t>
+            {
+                if (!scan(callback, true))
+                {
+                    trim();
+                    return error;
+                }
+
+                const auto result = error;
+
+                buffer.clear();
+                buffer_offset = 0;
+                position      = 0;
+                error.reset();
+
+                return result;
+            }
+
+            /**
+             * @brief True if a syntax error was found, no more tokens are reported until finish
+             */
+            constexpr auto failed() const noexcept -> bool
+            {
+                return error.has_value();
+            }
+
+            /**
+             * @brief Number of characters currently kept in memory
+             */
+            constexpr auto buffered() const noexcept
+            {
+                return buffer.size();
+            }
+    };
+}// namespace e_regex::tokenization
+
+#endif /* TOKENIZATION_STREAM_HPP */
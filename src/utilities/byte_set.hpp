@@ -0,0 +1,244 @@
+#ifndef UTILITIES_BYTE_SET
+#define UTILITIES_BYTE_SET
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace e_regex
+{
+    // Set of byte values, usable as a constant expression
+    struct byte_set
+    {
+            std::array<std::uint64_t, 4> words = {};
+
+            template<typename... Chars>
+            static constexpr auto of(Chars... chars) noexcept -> byte_set
+            {
+                byte_set set;
+                (set.insert(static_cast<unsigned char>(chars)), ...);
+
+                return set;
+            }
+
+            static constexpr auto all() noexcept -> byte_set
+            {
+                return ~byte_set {};
+            }
+
+            // Bytes outside of the ASCII range
+            static constexpr auto high() noexcept -> byte_set
+            {
+                byte_set set;
+                set.words[2] = set.words[3] = ~std::uint64_t {0};
+
+                return set;
+            }
+
+            constexpr auto insert(unsigned char c) noexcept -> byte_set&
+            {
+                words[c / 64] |= std::uint64_t {1} << (c % 64);
+
+                return *this;
+            }
+
+            constexpr auto contains(unsigned char c) const noexcept -> bool
+            {
+                return (words[c / 64] >> (c % 64) & 1) != 0;
+            }
+
+            constexpr auto size() const noexcept -> std::size_t
+            {
+                std::size_t size = 0;
+                for (auto word: words)
+                {
+                    size += static_cast<std::size_t>(std::popcount(word));
+                }
+
+                return size;
+            }
+
+            constexpr auto empty() const noexcept -> bool
+            {
+                return size() == 0;
+            }
+
+            // First count bytes of the set, in increasing order
+            template<std::size_t count>
+            constexpr auto first() const noexcept -> std::array<unsigned char, count>
+            {
+                std::array<unsigned char, count> result = {};
+                std::size_t                      found  = 0;
+
+                for (unsigned c = 0; c < 256 && found < count; ++c)
+                {
+                    if (contains(static_cast<unsigned char>(c)))
+                    {
+                        result[found++] = static_cast<unsigned char>(c);
+                    }
+                }
+
+                return result;
+            }
+
+            friend constexpr auto operator|(byte_set first, const byte_set& second) noexcept -> byte_set
+            {
+                for (std::size_t i = 0; i < first.words.size(); ++i)
+                {
+                    first.words[i] |= second.words[i];
+                }
+
+                return first;
+            }
+
+            friend constexpr auto operator&(byte_set first, const byte_set& second) noexcept -> byte_set
+            {
+                for (std::size_t i = 0; i < first.words.size(); ++i)
+                {
+                    first.words[i] &= second.words[i];
+                }
+
+                return first;
+            }
+
+            friend constexpr auto operator~(byte_set set) noexcept -> byte_set
+            {
+                for (auto& word: set.words)
+                {
+                    word = ~word;
+                }
+
+                return set;
+            }
+
+            constexpr auto operator==(const byte_set& other) const noexcept -> bool = default;
+    };
+
+    /*
+        Checks if every byte in bytes occurs in [begin, end). The input is processed in
+        blocks whose inner loops are plain OR-reductions, so that they get vectorized
+    */
+    template<std::size_t count>
+    constexpr auto bytes_present(const std::array<unsigned char, count>& bytes,
+                                 const char*                             begin,
+                                 const char*                             end) noexcept -> bool
+    {
+        static_assert(count <= 32);
+
+        constexpr std::ptrdiff_t block = 64;
+        std::uint32_t            missing
+            = count == 32 ? ~std::uint32_t {0} : (std::uint32_t {1} << count) - 1;
+
+        while (end - begin >= block)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto    byte  = static_cast<char>(bytes[i]);
+                unsigned char found = 0;
+
+                for (std::ptrdiff_t j = 0; j < block; ++j)
+                {
+                    found |= static_cast<unsigned char>(begin[j] == byte);
+                }
+
+                if (found != 0)
+                {
+                    missing &= ~(std::uint32_t {1} << i);
+                }
+            }
+
+            if (missing == 0)
+            {
+                return true;
+            }
+
+            begin += block;
+        }
+
+        for (; begin < end; ++begin)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (static_cast<unsigned char>(*begin) == bytes[i])
+                {
+                    missing &= ~(std::uint32_t {1} << i);
+                }
+            }
+        }
+
+        return missing == 0;
+    }
+
+    template<std::size_t count>
+    constexpr auto is_one_of(const std::array<unsigned char, count>& bytes, char c) noexcept -> unsigned char
+    {
+        unsigned char found = 0;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            found |= static_cast<unsigned char>(c == static_cast<char>(bytes[i]));
+        }
+
+        return found;
+    }
+
+    /*
+        First position of [begin, end) whose byte is not in bytes. Long runs are checked in
+        blocks whose inner loops are plain OR-reductions, so that they get vectorized
+    */
+    template<std::size_t count>
+    constexpr auto skip_bytes(const std::array<unsigned char, count>& bytes,
+                              const char*                             begin,
+                              const char*                             end) noexcept -> const char*
+    {
+        // Separators are usually short, their first bytes are checked one at a time
+        constexpr std::ptrdiff_t block  = 64;
+        constexpr std::ptrdiff_t prefix = 16;
+
+        for (std::ptrdiff_t i = 0; i < prefix && begin < end; ++i, ++begin)
+        {
+            if (is_one_of(bytes, *begin) == 0)
+            {
+                return begin;
+            }
+        }
+
+        while (end - begin >= block)
+        {
+            std::array<unsigned char, block> member = {};
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto byte = static_cast<char>(bytes[i]);
+
+                for (std::size_t j = 0; j < member.size(); ++j)
+                {
+                    member[j] |= static_cast<unsigned char>(begin[j] == byte);
+                }
+            }
+
+            unsigned char outside = 0;
+            for (const auto found: member)
+            {
+                outside |= found ^ 1U;
+            }
+
+            if (outside != 0)
+            {
+                break;
+            }
+
+            begin += block;
+        }
+
+        while (begin < end && is_one_of(bytes, *begin) != 0)
+        {
+            ++begin;
+        }
+
+        return begin;
+    }
+}// namespace e_regex
+
+#endif /* UTILITIES_BYTE_SET */
@@ -0,0 +1,59 @@
+#ifndef UTILITIES_HASH
+#define UTILITIES_HASH
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace e_regex
+{
+    // Little endian word made of count bytes from offset, compilers merge it into a single load
+    constexpr auto load_word(std::string_view bytes, std::size_t offset, std::size_t count) noexcept
+        -> std::uint64_t
+    {
+        std::uint64_t word = 0;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            word |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+        }
+
+        return word;
+    }
+
+    /*
+        Fast non-cryptographic hash of a token, meant for interning: 8 bytes are mixed at a
+        time with a multiplication and a shift, and the result goes through the finalizer of
+        MurmurHash3
+    */
+    constexpr auto hash_bytes(std::string_view bytes) noexcept -> std::uint64_t
+    {
+        constexpr std::uint64_t k0 = 0xa0761d6478bd642fULL;
+        constexpr std::uint64_t k1 = 0xe7037ed1a0b428dbULL;
+
+        std::uint64_t hash = k0 ^ (bytes.size() * k1);
+        std::size_t   i    = 0;
+
+        for (; i + 8 <= bytes.size(); i += 8)
+        {
+            hash = (hash ^ load_word(bytes, i, 8)) * k1;
+            hash ^= hash >> 29;
+        }
+
+        if (i < bytes.size())
+        {
+            hash = (hash ^ load_word(bytes, i, bytes.size() - i)) * k0;
+            hash ^= hash >> 29;
+        }
+
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+
+        return hash;
+    }
+}// namespace e_regex
+
+#endif /* UTILITIES_HASH */
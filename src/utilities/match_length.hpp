@@ -0,0 +1,54 @@
+#ifndef UTILITIES_MATCH_LENGTH
+#define UTILITIES_MATCH_LENGTH
+
+#include <cstddef>
+#include <limits>
+
+namespace e_regex
+{
+    // Length of a match that can grow without bounds, e.g. a*
+    inline constexpr auto unbounded_length = std::numeric_limits<std::size_t>::max();
+
+    // Saturating sum of match lengths
+    consteval auto length_sum(std::size_t n, std::size_t m) -> std::size_t
+    {
+        if (n == unbounded_length || m == unbounded_length || n > unbounded_length - m)
+        {
+            return unbounded_length;
+        }
+
+        return n + m;
+    }
+
+    // Saturating product of match lengths
+    consteval auto length_product(std::size_t n, std::size_t m) -> std::size_t
+    {
+        if (n == 0 || m == 0)
+        {
+            return 0;
+        }
+
+        if (n == unbounded_length || m == unbounded_length || n > unbounded_length / m)
+        {
+            return unbounded_length;
+        }
+
+        return n * m;
+    }
+
+    // Checks if at least min_length characters lie between start and end
+    template<std::size_t min_length>
+    constexpr auto fits_length(auto start, auto end) noexcept -> bool
+    {
+        if constexpr (min_length == 0)
+        {
+            return true;
+        }
+        else
+        {
+            return end - start >= static_cast<decltype(end - start)>(min_length);
+        }
+    }
+}// namespace e_regex
+
+#endif /* UTILITIES_MATCH_LENGTH */
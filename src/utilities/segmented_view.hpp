@@ -0,0 +1,201 @@
+#ifndef UTILITIES_SEGMENTED_VIEW
+#define UTILITIES_SEGMENTED_VIEW
+
+#include <compare>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "literal_string_view.hpp"
+
+namespace e_regex
+{
+    /*
+        Non-owning view over an input split in several segments (iovec, ropes, ring
+        buffers...). Iterators walk a raw pointer inside the current segment and only
+        move to the next one at its end.
+    */
+    template<typename Type = char>
+    class segmented_view
+    {
+        public:
+            using segment = std::basic_string_view<Type>;
+
+            class iterator
+            {
+                private:
+                    const segment* current_segment = nullptr;
+                    const segment* last_segment    = nullptr;
+                    const Type*    segment_begin   = nullptr;
+                    const Type*    segment_end     = nullptr;
+                    const Type*    current         = nullptr;
+
+                    // Absolute offset of segment_begin
+                    std::size_t segment_offset = 0;
+
+                    constexpr void skip_empty_segments() noexcept
+                    {
+                        while (current_segment != last_segment && current_segment->empty())
+                        {
+                            ++current_segment;
+                        }
+
+                        if (current_segment == last_segment)
+                        {
+                            segment_begin = segment_end = current = nullptr;
+                        }
+                        else
+                        {
+                            segment_begin = current = current_segment->data();
+                            segment_end             = segment_begin + current_segment->size();
+                        }
+                    }
+
+                    constexpr void next_segment() noexcept
+                    {
+                        segment_offset += static_cast<std::size_t>(segment_end - segment_begin);
+                        ++current_segment;
+
+                        skip_empty_segments();
+                    }
+
+                public:
+                    using value_type      = Type;
+                    using difference_type = std::ptrdiff_t;
+
+                    constexpr iterator() noexcept = default;
+
+                    constexpr iterator(const segment* first, const segment* last, std::size_t offset = 0) noexcept
+                        : current_segment {first}, last_segment {last}, segment_offset {offset}
+                    {
+                        skip_empty_segments();
+                    }
+
+                    // Absolute offset from the beginning of the view
+                    constexpr auto position() const noexcept -> std::size_t
+                    {
+                        return segment_offset + static_cast<std::size_t>(current - segment_begin);
+                    }
+
+                    constexpr auto operator*() const noexcept -> const Type&
+                    {
+                        return *current;
+                    }
+
+                    constexpr auto operator++() noexcept -> iterator&
+                    {
+                        if (++current == segment_end)
+                        {
+                            next_segment();
+                        }
+
+                        return *this;
+                    }
+
+                    constexpr auto operator++(int) noexcept -> iterator
+                    {
+                        auto copy = *this;
+                        ++*this;
+
+                        return copy;
+                    }
+
+                    constexpr auto operator+=(std::size_t n) noexcept -> iterator&
+                    {
+                        while (current != nullptr && n >= static_cast<std::size_t>(segment_end - current))
+                        {
+                            n -= static_cast<std::size_t>(segment_end - current);
+                            next_segment();
+                        }
+
+                        if (current != nullptr)
+                        {
+                            current += n;
+                        }
+
+                        return *this;
+                    }
+
+                    constexpr auto operator+(std::size_t n) const noexcept -> iterator
+                    {
+                        auto copy = *this;
+                        copy += n;
+
+                        return copy;
+                    }
+
+                    constexpr auto operator-(const iterator& other) const noexcept -> difference_type
+                    {
+                        return static_cast<difference_type>(position())
+                               - static_cast<difference_type>(other.position());
+                    }
+
+                    constexpr auto operator==(const iterator& other) const noexcept -> bool
+                    {
+                        return position() == other.position();
+                    }
+
+                    constexpr auto operator<=>(const iterator& other) const noexcept
+                    {
+                        return position() <=> other.position();
+                    }
+            };
+
+        private:
+            std::span<const segment> segments;
+            std::size_t              size_ = 0;
+
+        public:
+            constexpr segmented_view() noexcept = default;
+
+            constexpr segmented_view(std::span<const segment> segments) noexcept: segments {segments}
+            {
+                for (const auto& s: segments)
+                {
+                    size_ += s.size();
+                }
+            }
+
+            constexpr auto begin() const noexcept
+            {
+                return iterator {segments.data(), segments.data() + segments.size()};
+            }
+
+            constexpr auto end() const noexcept
+            {
+                const auto last = segments.data() + segments.size();
+
+                return iterator {last, last, size_};
+            }
+
+            constexpr auto size() const noexcept
+            {
+                return size_;
+            }
+
+            constexpr auto empty() const noexcept
+            {
+                return size_ == 0;
+            }
+    };
+
+    template<typename Type, std::size_t extent>
+    segmented_view(std::span<std::basic_string_view<Type>, extent>) -> segmented_view<Type>;
+
+    template<typename Type, std::size_t extent>
+    segmented_view(std::span<const std::basic_string_view<Type>, extent>) -> segmented_view<Type>;
+
+    // Segmented views are matched as they are, anything else as a contiguous query
+    template<typename Type>
+    constexpr auto to_query(segmented_view<Type> query) noexcept
+    {
+        return query;
+    }
+
+    constexpr auto to_query(literal_string_view<> query) noexcept
+    {
+        return query;
+    }
+}// namespace e_regex
+
+#endif /* UTILITIES_SEGMENTED_VIEW */
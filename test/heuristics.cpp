@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "e_regex.hpp"
@@ -87,4 +90,266 @@ TEST_CASE("Greedy backtracking removal")
     using matcher = typename e_regex::tree_builder<test>::tree;
 
     REQUIRE(matcher::expression::string.to_view() == R"(\d++\s++123)");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Match length bounds")
+{
+    constexpr e_regex::static_string regex {R"(\d{4}-\d{2}-\d{2})"};
+
+    using matcher = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex>>::tree;
+    REQUIRE(matcher::min_length == 10);
+    REQUIRE(matcher::max_length == 10);
+
+    constexpr e_regex::static_string regex1 {R"(ab?(c|def)x{2,5})"};
+
+    using matcher1 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex1>>::tree;
+    REQUIRE(matcher1::min_length == 4);
+    REQUIRE(matcher1::max_length == 10);
+
+    constexpr e_regex::static_string regex2 {R"(^a+|b$)"};
+
+    using matcher2 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex2>>::tree;
+    REQUIRE(matcher2::min_length == 1);
+    REQUIRE(matcher2::max_length == e_regex::unbounded_length);
+
+    static_assert(e_regex::min_match_length<"a{3}b*"> == 3);
+    static_assert(e_regex::max_match_length<"a{3}b*"> == e_regex::unbounded_length);
+
+    // Too short inputs and suffixes are never searched
+    REQUIRE(!e_regex::match<R"(\d{4})">("123"));
+    REQUIRE(!e_regex::contains<R"(\d{4})">("12 345"));
+    REQUIRE(e_regex::match<R"(\d{4})">("x1234"));
+
+    auto result = e_regex::match<R"(\d{3})">("123 45");
+    REQUIRE(result.to_view() == "123");
+    REQUIRE(!result.next());
+}
+
+TEST_CASE("Required bytes")
+{
+    constexpr e_regex::static_string regex {R"([\w.]+@\w+\.com)"};
+
+    using matcher = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex>>::tree;
+    REQUIRE(matcher::required_bytes == e_regex::byte_set::of('@', '.', 'c', 'o', 'm'));
+
+    // Bytes are required only if every alternative requires them
+    constexpr e_regex::static_string regex1 {"(ab|cb)x?d*(e|e)"};
+
+    using matcher1 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex1>>::tree;
+    REQUIRE(matcher1::required_bytes == e_regex::byte_set::of('b', 'e'));
+
+    constexpr e_regex::static_string regex2 {"[^a]b{0,2}"};
+
+    using matcher2 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex2>>::tree;
+    REQUIRE(matcher2::required_bytes.empty());
+
+    std::string line(200, 'x');
+    REQUIRE(!e_regex::match<R"(\w+@\w+\.com)">(std::string_view {line}));
+    REQUIRE(!e_regex::contains<R"(\w+@\w+\.com)">(std::string_view {line}));
+
+    line += " john@example.com";
+    REQUIRE(e_regex::match<R"(\w+@\w+\.com)">(std::string_view {line}).to_view() == "john@example.com");
+    REQUIRE(e_regex::contains<R"(\w+@\w+\.com)">(std::string_view {line}));
+}
+
+TEST_CASE("Literal patterns")
+{
+    constexpr e_regex::static_string regex {R"(needle\.txt)"};
+
+    using matcher = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex>>::tree;
+    REQUIRE(e_regex::literal_pattern<matcher>::value);
+    REQUIRE(
+        std::is_same_v<typename e_regex::literal_pattern<matcher>::string,
+                       e_regex::pack_string<'n', 'e', 'e', 'd', 'l', 'e', '.', 't', 'x', 't'>>);
+
+    constexpr e_regex::static_string regex1 {R"(needle\d)"};
+
+    using matcher1 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex1>>::tree;
+    REQUIRE(!e_regex::literal_pattern<matcher1>::value);
+
+    // Candidates with matching first and last bytes in several blocks
+    std::string haystack;
+    for (int i = 0; i < 20; ++i)
+    {
+        haystack += "nxxxxxxxxt needle-txt ";
+    }
+    haystack += "needle.txt";
+
+    auto result = e_regex::match<R"(needle\.txt)">(std::string_view {haystack});
+    REQUIRE(result);
+    REQUIRE(result.offset() == haystack.size() - 10);
+    REQUIRE(!result.next());
+
+    REQUIRE(e_regex::contains<"needle">(std::string_view {haystack}));
+    REQUIRE(!e_regex::contains<"needles">(std::string_view {haystack}));
+
+    static_assert(e_regex::contains<"dle">("needle"));
+    static_assert(!e_regex::contains<"dlee">("needle"));
+
+    std::array<e_regex::match_span, 32> spans {};
+    REQUIRE(e_regex::find_all<"needle">(std::string_view {haystack}, spans).count == 21);
+}
+
+TEST_CASE("Inner literals")
+{
+    constexpr e_regex::static_string regex {R"([\w.]+\.example\.com)"};
+
+    using literal = e_regex::inner_literal_t<
+        typename e_regex::tree_builder<e_regex::build_pack_string_t<regex>>::tree>;
+    REQUIRE(std::is_same_v<typename literal::type,
+                           e_regex::pack_string<'.', 'e', 'x', 'a', 'm', 'p', 'l', 'e', '.', 'c', 'o', 'm'>>);
+    REQUIRE(literal::prefix_min_length == 1);
+
+    constexpr e_regex::static_string regex1 {R"((\d+)\s+ERROR\s+(.*))"};
+
+    using literal1 = e_regex::inner_literal_t<
+        typename e_regex::tree_builder<e_regex::build_pack_string_t<regex1>>::tree>;
+    REQUIRE(std::is_same_v<typename literal1::type, e_regex::pack_string<'E', 'R', 'R', 'O', 'R'>>);
+    REQUIRE(literal1::prefix_min_length == 2);
+    REQUIRE(literal1::prefix_alphabet.contains('7'));
+    REQUIRE(literal1::prefix_alphabet.contains(' '));
+    REQUIRE(!literal1::prefix_alphabet.contains('E'));
+
+    constexpr e_regex::static_string regex2 {R"(\d+(ms|s))"};
+
+    using literal2 = e_regex::inner_literal_t<
+        typename e_regex::tree_builder<e_regex::build_pack_string_t<regex2>>::tree>;
+    REQUIRE(literal2::length == 0);
+
+    auto host = e_regex::match<R"([\w.]+\.example\.com)">("see .example.com, www.example.org or api.eu.example.com");
+    REQUIRE(host.to_view() == "api.eu.example.com");
+    REQUIRE(!host.next());
+
+    auto [duration, value] = e_regex::match<R"((\d+)ms)">("ms, 12 ms, x3ms 45ms");
+    REQUIRE(duration == "3ms");
+    REQUIRE(value == "3");
+
+    auto lazy = e_regex::match<R"(a.*?b)">("xxa1b2b");
+    REQUIRE(lazy.to_view() == "a1b");
+
+    // The start of the match lies before the previous occurrence of the suffix
+    REQUIRE(e_regex::match<R"(\w+bb)">("-abbb").to_view() == "abbb");
+    REQUIRE(e_regex::match<R"([^-]+x)">("-x-yx").to_view() == "yx");
+
+    auto [line, code, message]
+        = e_regex::match<R"((\d+)\s+ERROR\s+(\w+))">("12 INFO ok, 7 ERRORS, 404  ERROR missing");
+    REQUIRE(line == "404  ERROR missing");
+    REQUIRE(code == "404");
+    REQUIRE(message == "missing");
+
+    auto email = e_regex::match<R"(\w+@\w+\.\w+)">("a@ b @c.d x@y z@host.com");
+    REQUIRE(email.to_view() == "z@host.com");
+}
+
+TEST_CASE("Class sequences")
+{
+    constexpr e_regex::static_string regex {R"(\d{4}-\d{2}-\d{2})"};
+
+    using matcher = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex>>::tree;
+    constexpr auto classes = e_regex::classes_of<matcher>();
+    REQUIRE(classes.valid);
+    REQUIRE(classes.length == 10);
+    REQUIRE(classes.sets[4] == e_regex::byte_set::of('-'));
+    REQUIRE(classes.sets[0].contains('7'));
+    REQUIRE(!classes.sets[0].contains('a'));
+
+    constexpr e_regex::static_string regex1 {R"([0-9a-f]{8}-(x|y)[0-9a-f]{3})"};
+
+    using matcher1 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex1>>::tree;
+    REQUIRE(e_regex::classes_of<matcher1>().length == 13);
+    REQUIRE(e_regex::classes_of<matcher1>().sets[9] == e_regex::byte_set::of('x', 'y'));
+
+    constexpr e_regex::static_string regex2 {R"(\d{2,4}-\d)"};
+
+    using matcher2 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex2>>::tree;
+    REQUIRE(!e_regex::classes_of<matcher2>().valid);
+
+    auto date = e_regex::match<R"((\d{4})-\d{2}-\d{2})">("12-34 2023-1-05, 99 2023-01-051");
+    REQUIRE(date.to_view() == "2023-01-05");
+    REQUIRE(date[1] == "2023");
+    REQUIRE(!date.next());
+
+    auto id = e_regex::match<R"([0-9a-f]{8}-(x|y)[0-9a-f]{3})">("0123abcd-z123 ffffffff-y0a1");
+    REQUIRE(id.to_view() == "ffffffff-y0a1");
+}
+
+TEST_CASE("Class validators")
+{
+    constexpr e_regex::static_string regex {R"([0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12})"};
+
+    using matcher = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex>>::tree;
+    REQUIRE(e_regex::class_validator<matcher>::enabled);
+    REQUIRE(e_regex::class_validator<matcher>::length == 36);
+
+    constexpr auto uuid = e_regex::full_match<R"([0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12})">;
+    REQUIRE(uuid("123e4567-e89b-12d3-a456-426614174000"));
+    REQUIRE(!uuid("123e4567-e89b-12d3-a456-42661417400g"));
+    REQUIRE(!uuid("123e4567xe89b-12d3-a456-426614174000"));
+    REQUIRE(!uuid("123e4567-e89b-12d3-a456-4266141740001"));
+
+    // Exact sets, '.' does not match new lines and negated classes match any other byte
+    REQUIRE(e_regex::full_match<R"(\d.[^a])">("1x\xff"));
+    REQUIRE(!e_regex::full_match<R"(\d.[^a])">("1\nb"));
+    REQUIRE(!e_regex::full_match<R"(\d.[^a])">("1xa"));
+    REQUIRE(e_regex::full_match<R"(\w\s(x|y))">("a\ty"));
+
+    // Anchors are left to the matcher
+    constexpr e_regex::static_string regex1 {R"(^\d{2}$)"};
+
+    using matcher1 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex1>>::tree;
+    REQUIRE(!e_regex::class_validator<matcher1>::enabled);
+    REQUIRE(e_regex::full_match<R"(^\d{2}$)">("42"));
+
+    // Alternatives differing in more than one position can not be merged
+    constexpr e_regex::static_string regex2 {R"((19|20)\d\d)"};
+
+    using matcher2 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex2>>::tree;
+    REQUIRE(!e_regex::class_validator<matcher2>::enabled);
+    REQUIRE(e_regex::full_match<R"((19|20)\d\d)">("1999"));
+    REQUIRE(!e_regex::full_match<R"((19|20)\d\d)">("1099"));
+    REQUIRE(e_regex::full_match<"ab|cd">("cd"));
+    REQUIRE(!e_regex::full_match<"ab|cd">("ad"));
+    REQUIRE(e_regex::full_match<"x(ab|cd)">("xab"));
+    REQUIRE(!e_regex::full_match<"x(ab|cd)">("xcb"));
+
+    // Alternatives differing in one position are a class
+    constexpr e_regex::static_string regex3 {R"(x(ab|ac)\d)"};
+
+    using matcher3 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex3>>::tree;
+    REQUIRE(e_regex::class_validator<matcher3>::enabled);
+    REQUIRE(e_regex::full_match<R"(x(ab|ac)\d)">("xac1"));
+    REQUIRE(!e_regex::full_match<R"(x(ab|ac)\d)">("xbc1"));
+}
+
+TEST_CASE("Separator runs")
+{
+    constexpr e_regex::static_string regex {R"(\s+)"};
+
+    using matcher = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex>>::tree;
+    REQUIRE(e_regex::tokenization::run_class<matcher> == e_regex::byte_set::of(' ', '\t', '\n', '\f', '\r'));
+
+    constexpr e_regex::static_string regex1 {R"([,;])"};
+
+    using matcher1 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex1>>::tree;
+    REQUIRE(e_regex::tokenization::run_class<matcher1> == e_regex::byte_set::of(',', ';'));
+
+    // Separators longer than one byte, or that can be empty, are not runs of a class
+    constexpr e_regex::static_string regex2 {R"(\s{2,})"};
+    constexpr e_regex::static_string regex3 {R"(\s*?)"};
+    constexpr e_regex::static_string regex4 {R"(\s+,)"};
+
+    using matcher2 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex2>>::tree;
+    using matcher3 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex3>>::tree;
+    using matcher4 = typename e_regex::tree_builder<e_regex::build_pack_string_t<regex4>>::tree;
+    REQUIRE(e_regex::tokenization::run_class<matcher2>.empty());
+    REQUIRE(e_regex::tokenization::run_class<matcher3>.empty());
+    REQUIRE(e_regex::tokenization::run_class<matcher4>.empty());
+
+    // Long runs are skipped in blocks
+    const std::string text = "a" + std::string(300, ' ') + "b\t\t" + std::string(100, '\n') + "c";
+    REQUIRE(e_regex::count_tokens<"[a-z]+", R"(\s+)">(std::string_view {text}) == 3);
+    REQUIRE(e_regex::count_tokens<"[a-z]+", R"(\s)">(std::string_view {text}) == 3);
+
+    // Separator bytes that can start a token are matched as usual
+    REQUIRE(e_regex::count_tokens<R"([a-z]+|\s\d)", R"(\s+)">(std::string_view {"ab 1 c"}) == 3);
+}
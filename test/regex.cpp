@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <e_regex.hpp>
 #include <tokenizer.hpp>
@@ -306,10 +310,28 @@ TEST_CASE("Multiple branches")
 
     REQUIRE(match.next());
     REQUIRE(match[0] == "d");
+    REQUIRE(match.branch() == 3);
 
     REQUIRE(!match.next());
 }
 
+TEST_CASE("Branch index")
+{
+    auto match = e_regex::match<"a|bc|cd|d">("abcd");
+    REQUIRE(match.branch() == 0);
+    REQUIRE(match.next());
+    REQUIRE(match.branch() == 1);
+
+    // The longest alternative wins, the first one on ties
+    REQUIRE(e_regex::match<"aaa|a+">("aaaa").branch() == 1);
+    REQUIRE(e_regex::match<"a+|aaa">("aaa").branch() == 0);
+
+    // Groups matching the empty string do not hide their branch
+    REQUIRE(e_regex::match<"(x*)b|(c)">("b").branch() == 0);
+    REQUIRE(e_regex::match<"(x*)b|(c)", e_regex::captures::none>("c").branch() == 1);
+    REQUIRE(e_regex::match_at<"(x*)b|(c)">("bc", 1).branch() == 1);
+}
+
 TEST_CASE("Negated matchers")
 {
     constexpr auto matcher = e_regex::match<"a[^a-fh]+">;
@@ -434,3 +456,373 @@ TEST_CASE("Lazy, greedy and possessive braces")
 
     REQUIRE(!match_possessive.is_accepted());
 }
+
+TEST_CASE("Backtracking through continuations")
+{
+    constexpr auto matcher = e_regex::match<"(ab|a)bc">;
+
+    constexpr auto match = matcher("abc");
+    REQUIRE(match.is_accepted());
+    REQUIRE(match[0] == "abc");
+    REQUIRE(match[1] == "a");
+
+    constexpr auto matcher_lazy = e_regex::match<"a+?b">;
+
+    REQUIRE(!matcher_lazy("aa").is_accepted());
+    REQUIRE(matcher_lazy("aab").to_view() == "aab");
+
+    constexpr auto matcher_nested = e_regex::match<"((a+)b)+c">;
+
+    constexpr auto nested = matcher_nested("aabababc");
+    REQUIRE(nested.is_accepted());
+    REQUIRE(nested[0] == "aabababc");
+    REQUIRE(nested[1] == "ab");
+    REQUIRE(nested[2] == "a");
+
+    REQUIRE(!e_regex::match<"x[^a]">("x").is_accepted());
+}
+
+TEST_CASE("Capture-free matching")
+{
+    constexpr auto matcher = e_regex::match<R"((\d+)-(\d+)-(\d+))", e_regex::captures::none>;
+
+    constexpr auto match = matcher("date: 2023-01-01");
+
+    REQUIRE(match.is_accepted());
+    REQUIRE(match.groups() == 0);
+    REQUIRE(match.to_view() == "2023-01-01");
+    REQUIRE(match[1].empty());
+
+    auto [full] = matcher("1970-01-01");
+    REQUIRE(full == "1970-01-01");
+
+    auto iterating = e_regex::match<"a(b)", e_regex::captures::none>("abzab");
+    REQUIRE(iterating.to_view() == "ab");
+    REQUIRE(iterating.next());
+    REQUIRE(iterating.to_view() == "ab");
+    REQUIRE(!iterating.next());
+}
+
+TEST_CASE("Boolean tests")
+{
+    constexpr auto contains = e_regex::contains<R"(\d+-\d+)">;
+
+    REQUIRE(contains("phone: 555-1234"));
+    REQUIRE(!contains("phone: 5551234"));
+    REQUIRE(!contains(""));
+    REQUIRE(e_regex::contains<"a*">(""));
+    REQUIRE(e_regex::contains<"$">("ab"));
+    REQUIRE(e_regex::contains<"x*$">("ab"));
+    REQUIRE(!e_regex::contains<"^$">("ab"));
+
+    constexpr auto full_match = e_regex::full_match<R"((\d+)-(\d+)-(\d+))">;
+
+    REQUIRE(full_match("2023-01-01"));
+    REQUIRE(!full_match("2023-01-01 "));
+    REQUIRE(!full_match(" 2023-01-01"));
+
+    REQUIRE(e_regex::full_match<"a|ab">("ab"));
+    REQUIRE(e_regex::full_match<"a{2,3}">("aaa"));
+    REQUIRE(!e_regex::full_match<"a{2,3}">("aaaa"));
+    REQUIRE(!e_regex::full_match<"a{2,3}">("a"));
+
+    // Alternatives inside repetitions are not cut short
+    REQUIRE(e_regex::full_match<"(a|ab)*">("ab"));
+    REQUIRE(e_regex::full_match<"(a|ab)*c">("ababc"));
+    REQUIRE(e_regex::full_match<"(a|ab)+">("aab"));
+    REQUIRE(e_regex::contains<"^(a|ab)*c">("ababc"));
+    REQUIRE(e_regex::full_match<"(x(a|ab)y?)*">("xabxa"));
+
+    static_assert(e_regex::full_match<"[a-f]+\\d">("abc1"));
+}
+
+TEST_CASE("Batch matching")
+{
+    constexpr std::string_view text = "a1 bb22 ccc333 d4";
+
+    std::array<e_regex::match_span, 3> spans {};
+
+    auto batch = e_regex::find_all<R"(\d+)">(text, spans);
+
+    REQUIRE(batch.count == 3);
+    REQUIRE(spans[0] == e_regex::match_span {.offset = 1, .length = 1});
+    REQUIRE(spans[1] == e_regex::match_span {.offset = 5, .length = 2});
+    REQUIRE(spans[2] == e_regex::match_span {.offset = 11, .length = 3});
+
+    batch = e_regex::find_all<R"(\d+)">(text, spans, batch.next_offset);
+
+    REQUIRE(batch.count == 1);
+    REQUIRE(spans[0] == e_regex::match_span {.offset = 16, .length = 1});
+    REQUIRE(batch.next_offset == text.size());
+
+    std::size_t total = 0;
+    e_regex::for_each_match<R"(\w+)">(text,
+                                      [&](e_regex::match_span span)
+                                      {
+                                          total += span.length;
+                                      });
+
+    REQUIRE(total == 7);
+
+    // Empty matches can start at the end of the query
+    std::array<e_regex::match_span, 4> empty_spans {};
+
+    batch = e_regex::find_all<"x*">(std::string_view {}, empty_spans);
+    REQUIRE(batch.count == 1);
+    REQUIRE(empty_spans[0] == e_regex::match_span {.offset = 0, .length = 0});
+    REQUIRE(e_regex::find_all<"x*">(std::string_view {}, empty_spans, batch.next_offset).count == 0);
+
+    batch = e_regex::find_all<"$">(std::string_view {"ab"}, empty_spans);
+    REQUIRE(batch.count == 1);
+    REQUIRE(empty_spans[0] == e_regex::match_span {.offset = 2, .length = 0});
+
+    batch = e_regex::find_all<"x*">(std::string_view {"ax"}, empty_spans);
+    REQUIRE(batch.count == 3);
+    REQUIRE(empty_spans[1] == e_regex::match_span {.offset = 1, .length = 1});
+    REQUIRE(empty_spans[2] == e_regex::match_span {.offset = 2, .length = 0});
+
+    // Offsets past the query are rejected
+    REQUIRE(e_regex::find_all<R"(\d+)">(text, spans, text.size() + 1).count == 0);
+}
+
+TEST_CASE("Line index")
+{
+    constexpr std::string_view text = "a1\nbb22\n\nccc333 d4";
+
+    std::array<e_regex::match_span, 4> spans {};
+    REQUIRE(e_regex::find_all<R"(\d+)">(text, spans).count == 4);
+
+    e_regex::line_index lines {text};
+
+    REQUIRE(lines.locate(spans[3].offset) == e_regex::text_position {.line = 4, .column = 9});
+    REQUIRE(lines.locate(spans[0].offset) == e_regex::text_position {.line = 1, .column = 2});
+    REQUIRE(lines.locate(spans[1].offset) == e_regex::text_position {.line = 2, .column = 3});
+    REQUIRE(lines.locate(spans[2].offset) == e_regex::text_position {.line = 4, .column = 4});
+
+    // Newlines and the end of the text belong to the line they end
+    REQUIRE(lines.locate(2) == e_regex::text_position {.line = 1, .column = 3});
+    REQUIRE(lines.locate(text.size()) == e_regex::text_position {.line = 4, .column = 10});
+
+    std::string long_text(10000, 'a');
+    long_text[5000] = '\n';
+    e_regex::line_index long_lines {std::string_view {long_text}};
+    REQUIRE(long_lines.locate(9000) == e_regex::text_position {.line = 2, .column = 4000});
+}
+
+TEST_CASE("Pattern sets")
+{
+    constexpr auto patterns = e_regex::set<"ERROR", R"(\d+ms)", "(a*)b", "^start", "end$">;
+
+    auto matched = patterns("start: ERROR after 150ms");
+
+    REQUIRE(matched.size() == 5);
+    REQUIRE(matched[0]);
+    REQUIRE(matched[1]);
+    REQUIRE(!matched[2]);
+    REQUIRE(matched[3]);
+    REQUIRE(!matched[4]);
+
+    matched = patterns("b at the end");
+
+    REQUIRE(matched.count() == 2);
+    REQUIRE(matched[2]);
+    REQUIRE(matched[4]);
+
+    std::vector<std::pair<std::size_t, e_regex::match_span>> matches;
+    patterns.for_each_match("ab 10ms 20ms ERROR",
+                            [&](std::size_t pattern, e_regex::match_span span)
+                            {
+                                matches.emplace_back(pattern, span);
+                            });
+
+    REQUIRE(matches.size() == 4);
+    REQUIRE(matches[0].first == 2);
+    REQUIRE(matches[0].second == e_regex::match_span {.offset = 0, .length = 2});
+    REQUIRE(matches[1].first == 1);
+    REQUIRE(matches[1].second == e_regex::match_span {.offset = 3, .length = 4});
+    REQUIRE(matches[2].first == 1);
+    REQUIRE(matches[3].first == 0);
+    REQUIRE(matches[3].second == e_regex::match_span {.offset = 13, .length = 5});
+
+    // Empty matches can start at the end of the query, as with find_all
+    constexpr auto nullable = e_regex::set<"$", "q", "x*">;
+
+    auto nullable_matched = nullable("a");
+    REQUIRE(nullable_matched[0]);
+    REQUIRE(!nullable_matched[1]);
+    REQUIRE(nullable_matched[2]);
+
+    matches.clear();
+    nullable.for_each_match("ax",
+                            [&](std::size_t pattern, e_regex::match_span span)
+                            {
+                                matches.emplace_back(pattern, span);
+                            });
+
+    REQUIRE(matches.size() == 4);
+    REQUIRE(matches[0].first == 2);
+    REQUIRE(matches[0].second == e_regex::match_span {.offset = 0, .length = 0});
+    REQUIRE(matches[1].first == 2);
+    REQUIRE(matches[1].second == e_regex::match_span {.offset = 1, .length = 1});
+    REQUIRE(matches[2].first == 0);
+    REQUIRE(matches[2].second == e_regex::match_span {.offset = 2, .length = 0});
+    REQUIRE(matches[3].first == 2);
+    REQUIRE(matches[3].second == e_regex::match_span {.offset = 2, .length = 0});
+
+    matches.clear();
+    nullable.for_each_match("",
+                            [&](std::size_t pattern, e_regex::match_span span)
+                            {
+                                matches.emplace_back(pattern, span);
+                            });
+
+    REQUIRE(matches.size() == 2);
+    REQUIRE(matches[1].first == 2);
+    REQUIRE(matches[1].second == e_regex::match_span {.offset = 0, .length = 0});
+}
+
+TEST_CASE("Stream matching")
+{
+    e_regex::stream_matcher<R"(\d+ms)"> stream;
+
+    std::vector<std::pair<std::size_t, std::string>> matches;
+
+    auto callback = [&](std::size_t offset, std::string_view match)
+    {
+        matches.emplace_back(offset, match);
+    };
+
+    stream.feed("took 12", callback);
+    REQUIRE(matches.empty());
+    REQUIRE(stream.buffered() == 3);
+
+    stream.feed("0m", callback);
+    REQUIRE(matches.empty());
+
+    stream.feed("s, then 7ms and 3", callback);
+    REQUIRE(matches.size() == 2);
+    REQUIRE(matches[0] == std::pair<std::size_t, std::string> {5, "120ms"});
+    REQUIRE(matches[1] == std::pair<std::size_t, std::string> {17, "7ms"});
+
+    stream.finish(callback);
+    REQUIRE(matches.size() == 2);
+
+    e_regex::stream_matcher<"^ab|ab$"> anchored;
+    matches.clear();
+
+    anchored.feed("ab a", callback);
+    anchored.feed("b ab", callback);
+    REQUIRE(matches.size() == 1);
+
+    anchored.finish(callback);
+    REQUIRE(matches.size() == 2);
+    REQUIRE(matches[0].first == 0);
+    REQUIRE(matches[1].first == 6);
+
+    // Empty matches at the end of the stream are reported by finish
+    e_regex::stream_matcher<"$"> end;
+    matches.clear();
+
+    end.feed("ab", callback);
+    REQUIRE(matches.empty());
+
+    end.finish(callback);
+    REQUIRE(matches.size() == 1);
+    REQUIRE(matches[0] == std::pair<std::size_t, std::string> {2, ""});
+
+    e_regex::stream_matcher<"x*"> nullable;
+    matches.clear();
+
+    nullable.feed("aax", callback);
+    nullable.feed("xaax", callback);
+    nullable.finish(callback);
+    REQUIRE(matches.size() == 7);
+    REQUIRE(matches[2] == std::pair<std::size_t, std::string> {2, "xx"});
+    REQUIRE(matches[5] == std::pair<std::size_t, std::string> {6, "x"});
+    REQUIRE(matches[6] == std::pair<std::size_t, std::string> {7, ""});
+
+    e_regex::stream_matcher<"^$"> empty;
+    matches.clear();
+
+    empty.finish(callback);
+    REQUIRE(matches.size() == 1);
+    REQUIRE(matches[0].first == 0);
+}
+
+TEST_CASE("Segmented inputs")
+{
+    std::array<std::string_view, 4> segments {"took 1", "", "2", "0ms, 7m"};
+    e_regex::segmented_view view {std::span<const std::string_view> {segments}};
+
+    REQUIRE(view.size() == 14);
+    REQUIRE(e_regex::contains<R"(\d+ms)">(view));
+    REQUIRE(!e_regex::contains<"took 2">(view));
+    REQUIRE(e_regex::full_match<R"(took \d+ms, 7m)">(view));
+    REQUIRE(!e_regex::full_match<R"(took \d+ms)">(view));
+
+    std::array<e_regex::match_span, 4> spans {};
+    auto batch = e_regex::find_all<R"(\d+)">(view, spans);
+    REQUIRE(batch.count == 2);
+    REQUIRE(spans[0] == e_regex::match_span {5, 3});
+    REQUIRE(spans[1] == e_regex::match_span {12, 1});
+    REQUIRE(batch.next_offset == 14);
+
+    std::array<std::string_view, 2> anchored {"ab", "c"};
+    e_regex::segmented_view anchored_view {std::span {anchored}};
+    REQUIRE(e_regex::contains<"^abc$">(anchored_view));
+    REQUIRE(e_regex::contains<"c$">(anchored_view));
+    REQUIRE(!e_regex::contains<"^b">(anchored_view));
+}
+
+TEST_CASE("Matching at an offset")
+{
+    constexpr std::string_view text = "ab 12 cd 345";
+
+    auto number = e_regex::match_at<R"(\d+)">(text, 3);
+    REQUIRE(number);
+    REQUIRE(number.offset() == 3);
+    REQUIRE(number.length() == 2);
+    REQUIRE(number.to_view() == "12");
+
+    REQUIRE(!e_regex::match_at<R"(\d+)">(text, 2));
+    REQUIRE(!e_regex::match_at<R"(\d+)">(text, 20));
+
+    // Anchors keep referring to the whole text
+    REQUIRE(!e_regex::match_at<R"(^\d+)">(text, 3));
+    REQUIRE(e_regex::match_at<R"(\d+$)">(text, 9));
+
+    auto found = e_regex::search_from<R"(\d+)">(text, 5);
+    REQUIRE(found);
+    REQUIRE(found.offset() == 9);
+    REQUIRE(found.to_view() == "345");
+    REQUIRE(!found.next());
+
+    REQUIRE(!e_regex::search_from<R"(^\w+)">(text, 1));
+
+    // Empty matches can start at the end of the text, as with find_all
+    auto end = e_regex::search_from<"$">("ab", 0);
+    REQUIRE(end);
+    REQUIRE(end.offset() == 2);
+    REQUIRE(!end.next());
+
+    auto digits = e_regex::match<R"(\d*)">("a12");
+    REQUIRE(digits.offset() == 0);
+    REQUIRE(digits.next());
+    REQUIRE(digits.to_view() == "12");
+    REQUIRE(digits.next());
+    REQUIRE(digits.offset() == 3);
+    REQUIRE(digits.to_view().empty());
+    REQUIRE(!digits.next());
+
+    auto [all, group] = e_regex::match_at<R"((\w)d)">(text, 6);
+    REQUIRE(all == "cd");
+    REQUIRE(group == "c");
+}
+
+TEST_CASE("Overlapping attempts")
+{
+    // A failed attempt must not skip the positions it has read
+    REQUIRE(e_regex::match<"ab">("aab").to_view() == "ab");
+    REQUIRE(e_regex::match<R"(a\d)">("aa1").to_view() == "a1");
+    REQUIRE(e_regex::match<R"(a\d)">("xaa1").to_view() == "a1");
+}
@@ -1,5 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "e_regex.hpp"
@@ -64,6 +69,30 @@ TEST_CASE("Classified tokenization")
     REQUIRE(tokens[2].type == type::NUMBER);
 }
 
+TEST_CASE("Classified tokenization with empty groups")
+{
+    enum class type
+    {
+        IDENTIFIER,
+        NUMBER
+    };
+
+    constexpr auto tokenizer = e_regex::tokenize<"(x*)[a-z]+|(\\d+)", "\\s", type>;
+
+    std::vector<decltype(*tokenizer("").begin())> tokens;
+
+    for (auto token: tokenizer("ab 12"))
+    {
+        tokens.push_back(token);
+    }
+
+    REQUIRE(tokens.size() == 2);
+    REQUIRE(tokens[0].string == "ab");
+    REQUIRE(tokens[0].type == type::IDENTIFIER);
+    REQUIRE(tokens[1].string == "12");
+    REQUIRE(tokens[1].type == type::NUMBER);
+}
+
 TEST_CASE("Constexpr classified tokenization")
 {
     enum class type
@@ -83,4 +112,274 @@ TEST_CASE("Constexpr classified tokenization")
     REQUIRE(tokens[1].type == type::WORD);
     REQUIRE(tokens[2].string == "123");
     REQUIRE(tokens[2].type == type::NUMBER);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tokenization syntax errors")
+{
+    constexpr auto tokenizer = e_regex::tokenize<"[a-z]+|=", "\\s+">;
+
+    std::vector<std::string_view> tokens;
+    for (auto token: tokenizer("  key = value"))
+    {
+        tokens.push_back(token);
+    }
+
+    REQUIRE(tokens == std::vector<std::string_view> {"key", "=", "value"});
+
+    // Tokens end at the first character that is neither a token nor a separator
+    tokens.clear();
+    for (auto token: tokenizer("ab cd 12 ef"))
+    {
+        tokens.push_back(token);
+    }
+
+    REQUIRE(tokens == std::vector<std::string_view> {"ab", "cd"});
+
+    // Positions of tokens, e.g. of the last one before a syntax error
+    const auto res  = tokenizer("ab\ncd 12 ef");
+    auto       last = res.begin();
+    for (auto i = res.begin(); i != res.end(); ++i)
+    {
+        last = i;
+    }
+
+    REQUIRE(res.lines().locate(*last) == e_regex::text_position {.line = 2, .column = 1});
+
+    // Counting and validation do not build tokens
+    REQUIRE(e_regex::count_tokens<"[a-z]+|=", "\\s+">("  key = value ") == 3);
+    REQUIRE(e_regex::count_tokens<"[a-z]+|=", "\\s+">("ab cd 12 ef") == 2);
+    REQUIRE(!e_regex::validate_tokens<"[a-z]+|=", "\\s+">("  key = value "));
+    REQUIRE(e_regex::validate_tokens<"[a-z]+|=", "\\s+">("ab cd 12 ef") == 6);
+    REQUIRE(!e_regex::validate_tokens<"[a-z]+|=", "\\s+">(""));
+    static_assert(e_regex::count_tokens<"[a-z]+|=", "\\s+">("a=b") == 3);
+
+    // Tokens with no separator between them must be consecutive
+    REQUIRE(e_regex::tokenize<"[a-z]+|\\d+", ",">("ab12cd").count() == 3);
+    REQUIRE(e_regex::tokenize<"[a-z]+|\\d+", ",">("ab 12cd").count() == 1);
+}
+
+TEST_CASE("Columnar tokenization")
+{
+    constexpr auto tokenizer = e_regex::tokenize_into<"([a-z]+)|(\\d+)|(=)", "\\s+">;
+
+    constexpr std::string_view text = "key = 42 value=7";
+
+    std::array<std::uint8_t, 3>  types {};
+    std::array<std::uint32_t, 3> offsets {};
+    std::array<std::uint32_t, 3> lengths {};
+
+    const e_regex::tokenization::columns<std::uint8_t> out {types, offsets, lengths};
+
+    auto filled = tokenizer(text, out);
+    REQUIRE(filled.count == 3);
+    REQUIRE(!filled.complete);
+    REQUIRE(types == std::array<std::uint8_t, 3> {0, 2, 1});
+    REQUIRE(offsets == std::array<std::uint32_t, 3> {0, 4, 6});
+    REQUIRE(lengths == std::array<std::uint32_t, 3> {3, 1, 2});
+
+    // Full columns are resumed from the end of the last token
+    filled = tokenizer(text, out, filled.position);
+    REQUIRE(filled.count == 3);
+    REQUIRE(types == std::array<std::uint8_t, 3> {0, 2, 1});
+    REQUIRE(offsets == std::array<std::uint32_t, 3> {9, 14, 15});
+
+    filled = tokenizer(text, out, filled.position);
+    REQUIRE(filled.count == 0);
+    REQUIRE(filled.complete);
+
+    // The type column is optional
+    const e_regex::tokenization::columns<std::uint16_t> untyped {{}, offsets, lengths};
+    filled = tokenizer(text, untyped);
+    REQUIRE(filled.count == 3);
+    REQUIRE(lengths == std::array<std::uint32_t, 3> {3, 1, 2});
+}
+
+TEST_CASE("Stream tokenization")
+{
+    e_regex::stream_tokenizer<"[a-z]+|\\d+", "\\s+"> stream;
+
+    std::vector<std::pair<std::size_t, std::string>> tokens;
+
+    auto callback = [&](std::size_t offset, std::string_view token)
+    { tokens.emplace_back(offset, token); };
+
+    // Tokens straddling chunk boundaries are held back until they are complete
+    stream.feed("ab", callback);
+    REQUIRE(tokens.empty());
+
+    stream.feed("c 12", callback);
+    REQUIRE(tokens == std::vector<std::pair<std::size_t, std::string>> {{0, "abc"}});
+    REQUIRE(stream.buffered() <= 3);
+
+    stream.feed("3 de  ", callback);
+    stream.feed("f", callback);
+    REQUIRE(tokens.size() == 3);
+
+    REQUIRE(!stream.finish(callback));
+    REQUIRE(tokens
+            == std::vector<std::pair<std::size_t, std::string>> {{0, "abc"}, {4, "123"}, {8, "de"}, {12, "f"}});
+
+    // Syntax errors stop the stream
+    tokens.clear();
+    stream.feed("ab !cd", callback);
+    REQUIRE(stream.failed());
+    REQUIRE(stream.finish(callback) == 3);
+    REQUIRE(tokens == std::vector<std::pair<std::size_t, std::string>> {{0, "ab"}});
+
+    enum class type
+    {
+        WORD,
+        NUMBER
+    };
+
+    e_regex::stream_tokenizer<"[a-z]+|\\d+", "\\s", type> typed;
+
+    std::vector<type> types;
+    auto typed_callback = [&](std::size_t, auto token) { types.push_back(token.type); };
+
+    typed.feed("a 1", typed_callback);
+    typed.finish(typed_callback);
+    REQUIRE(types == std::vector<type> {type::WORD, type::NUMBER});
+
+    // Tokens left by a callback stopping finish are reported by the next call
+    tokens.clear();
+
+    auto first = [&](std::size_t offset, std::string_view token)
+    {
+        tokens.emplace_back(offset, token);
+        return false;
+    };
+
+    stream.feed("ab 12 cd", first);
+    REQUIRE(tokens.size() == 1);
+
+    REQUIRE(!stream.finish(first));
+    REQUIRE(tokens.size() == 2);
+    REQUIRE(stream.buffered() > 0);
+
+    REQUIRE(!stream.finish(callback));
+    REQUIRE(tokens == std::vector<std::pair<std::size_t, std::string>> {{0, "ab"}, {3, "12"}, {6, "cd"}});
+    REQUIRE(stream.buffered() == 0);
+}
+
+TEST_CASE("Parallel tokenization")
+{
+    // Quoted strings contain separators, so chunks can start inside them
+    std::string text;
+    for (int i = 0; i < 200; ++i)
+    {
+        text += i % 3 == 0 ? "\"a b c\" " : "word 12 ";
+    }
+
+    constexpr auto tokenizer = e_regex::tokenize<"\"[^\"]*\"|[a-z]+|\\d+", " ">;
+
+    std::vector<std::uint32_t> offsets;
+    for (auto token: tokenizer(std::string_view {text}))
+    {
+        offsets.push_back(static_cast<std::uint32_t>(token.begin() - text.data()));
+    }
+
+    for (std::size_t threads: {1, 2, 3, 7, 64})
+    {
+        const auto table = e_regex::tokenize_parallel<"\"[^\"]*\"|[a-z]+|\\d+", " ">(std::string_view {text},
+                                                                                          threads);
+
+        REQUIRE(table.offsets == offsets);
+        REQUIRE(table.types[0] == 0);
+        REQUIRE(table.types[1] == 1);
+        REQUIRE(table.types[2] == 2);
+        REQUIRE(table.lengths[0] == 7);
+    }
+
+    REQUIRE(e_regex::tokenize_parallel<"[a-z]+", " ">("", 4).size() == 0);
+}
+
+TEST_CASE("Keyword classification")
+{
+    enum class type
+    {
+        IDENTIFIER,
+        NUMBER,
+        IF,
+        ELSE,
+        WHILE
+    };
+
+    using keywords = e_regex::keywords<type::IDENTIFIER, type::IF, "if", "else", "while">;
+
+    constexpr auto tokenizer = e_regex::tokenize<"[a-z]+|\\d+", "\\s+", keywords>;
+
+    std::vector<type> types;
+    for (auto token: tokenizer("if x else while1 whilex 12 i"))
+    {
+        types.push_back(token.type);
+    }
+
+    REQUIRE(types
+            == std::vector<type> {type::IF,
+                                  type::IDENTIFIER,
+                                  type::ELSE,
+                                  type::WHILE,
+                                  type::NUMBER,
+                                  type::IDENTIFIER,
+                                  type::NUMBER,
+                                  type::IDENTIFIER});
+
+    // Words with the same length, first, middle and last characters need a hash of every byte
+    using similar = e_regex::keywords<type::IDENTIFIER, type::IF, "abzc", "axzc", "ayzc">;
+    REQUIRE(similar::classify(type::IDENTIFIER, "axzc") == type::ELSE);
+    REQUIRE(similar::classify(type::IDENTIFIER, "awzc") == type::IDENTIFIER);
+    REQUIRE(similar::classify(type::NUMBER, "abzc") == type::NUMBER);
+
+    using t = e_regex::token_t<"[a-z]+|\\d+", "else 1", "\\s", keywords>;
+    static_assert(t::tokens::tokens[0].type == type::ELSE);
+    static_assert(t::tokens::tokens[1].type == type::NUMBER);
+}
+
+TEST_CASE("Hashed tokens")
+{
+    enum class type
+    {
+        IDENTIFIER,
+        NUMBER,
+        NIL
+    };
+
+    constexpr auto tokenizer = e_regex::tokenize<"[a-z]+|\\d+", "\\s+", e_regex::hashed<type>>;
+
+    std::vector<std::uint64_t> hashes;
+    for (auto token: tokenizer("alpha 42 alpha beta"))
+    {
+        REQUIRE(token.hash == e_regex::hash_bytes(token.string));
+        hashes.push_back(token.hash);
+    }
+
+    REQUIRE(hashes.size() == 4);
+    REQUIRE(hashes[0] == hashes[2]);
+    REQUIRE(hashes[0] != hashes[3]);
+    REQUIRE(hashes[0] != hashes[1]);
+
+    // Lengths are mixed in, so that zero bytes are not lost
+    REQUIRE(e_regex::hash_bytes(std::string_view {"a\0", 2}) != e_regex::hash_bytes("a"));
+    REQUIRE(e_regex::hash_bytes("identifier_long") != e_regex::hash_bytes("identifier_lonh"));
+
+    // Keywords can be hashed too
+    using keywords = e_regex::hashed<e_regex::keywords<type::IDENTIFIER, type::NIL, "nil">>;
+    auto token     = *e_regex::tokenize<"[a-z]+|\\d+", "\\s+", keywords>("nil").begin();
+    REQUIRE(token.type == type::NIL);
+    REQUIRE(token.hash == e_regex::hash_bytes("nil"));
+
+    e_regex::stream_tokenizer<"[a-z]+|\\d+", "\\s+", keywords> stream;
+    std::uint64_t                                             streamed = 0;
+    stream.feed("alpha ", [&](std::size_t, auto token) { streamed = token.hash; });
+    REQUIRE(streamed == hashes[0]);
+
+    // In columns, hashes are written if their column is not empty
+    std::array<std::uint32_t, 4> offsets {};
+    std::array<std::uint32_t, 4> lengths {};
+    std::array<std::uint64_t, 4> column {};
+
+    const e_regex::tokenization::columns<std::uint8_t> out {{}, offsets, lengths, column};
+    REQUIRE(e_regex::tokenize_into<"[a-z]+|\\d+", "\\s+">("alpha 42 alpha beta", out).count == 4);
+    REQUIRE(std::vector<std::uint64_t> {column.begin(), column.end()} == hashes);
+}